@@ -0,0 +1,741 @@
+/* Microbenchmarks for argparse, run with `make bench`. */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "argparse.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+/* Minimum wall time spent in each benchmark. */
+#define BENCH_MIN_NS 200000000.0
+
+#define BENCH_MAX_ARGS 4096
+#define BENCH_LIST_VALUES 100000
+#define BENCH_GNU_ARGS 64
+#define BENCH_GNU_TOKENS 4096
+#define BENCH_GETTER_ARGS 64
+#define BENCH_GETTER_CALLS 1024
+#define BENCH_STRING_VALUES 10000
+#define BENCH_SUBCOMMANDS 30
+#define BENCH_SUBCOMMAND_ARGS 40
+#define BENCH_ABBREV_ARGS 1024
+#define BENCH_BATCH_VECTORS 1024
+#define BENCH_BATCH_ARGS 16
+#define BENCH_RULES_ARGS 1024
+#define BENCH_COMPLETE_ARGS 1024
+
+/* Allocation counting; the makefile links with -Wl,--wrap where the linker supports it. */
+static unsigned long long g_allocations = 0;
+
+#ifdef ARGPARSE_BENCH_WRAP
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+
+void* __wrap_malloc(size_t size) {
+    g_allocations++;
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+    g_allocations++;
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+    g_allocations++;
+    return __real_realloc(ptr, size);
+}
+#endif
+
+static double now_ns(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart * 1e9 / (double)frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+#endif
+}
+
+typedef struct Bench {
+    const char* name;
+    void (*setup)(void);     /* Untimed, may be NULL */
+    void (*run)(void);       /* One timed iteration */
+    void (*teardown)(void);  /* Untimed, may be NULL */
+    long ops;                /* Operations performed by one run() call */
+} Bench;
+
+/* Keeps getter results observable so the calls are not optimized out. */
+static volatile long g_sink = 0;
+
+static char g_names[BENCH_MAX_ARGS][24];
+static int g_construct_count = 0;
+
+static char** g_argv = NULL;
+static int g_argc = 0;
+
+static ArgParser* g_parser = NULL;
+
+static void fail(const char* what) {
+    fprintf(stderr, "bench: %s failed: %s\n", what, argparse_get_last_error_message());
+    exit(EXIT_FAILURE);
+}
+
+static char* dup_string(const char* str) {
+    char* copy = (char*)malloc(strlen(str) + 1);
+    if (!copy) fail("malloc");
+    strcpy(copy, str);
+    return copy;
+}
+
+static char* format_dup(const char* format, long value) {
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), format, value);
+    return dup_string(buffer);
+}
+
+static void alloc_argv(int argc) {
+    g_argv = (char**)calloc((size_t)argc + 1, sizeof(char*));
+    if (!g_argv) fail("calloc");
+    g_argc = argc;
+    g_argv[0] = dup_string("bench");
+}
+
+static void free_argv(void) {
+    for (int i = 0; i < g_argc; i++)
+        free(g_argv[i]);
+    free(g_argv);
+    g_argv = NULL;
+    g_argc = 0;
+}
+
+static void free_parser(void) {
+    argparse_free(g_parser);
+    g_parser = NULL;
+}
+
+/* ---- construction around ARGPARSE_HASH_THRESHOLD ---- */
+
+static void construct_run(void) {
+    ArgParser* parser = argparse_new("bench");
+
+    for (int i = 0; i < g_construct_count; i++)
+        argparse_add_argument(parser, NULL, g_names[i], ARG_INT, "value", false, NULL);
+
+    if (argparse_error_occurred()) fail("construct");
+    argparse_free(parser);
+}
+
+static void construct_8(void) { g_construct_count = 8; }
+static void construct_16(void) { g_construct_count = 16; }
+static void construct_256(void) { g_construct_count = 256; }
+static void construct_4096(void) { g_construct_count = 4096; }
+
+/* ---- loading the same 4096 arguments from a schema blob ---- */
+
+static void* g_schema = NULL;
+static size_t g_schema_size = 0;
+
+static void schema_setup(void) {
+    ArgParser* parser = argparse_new("bench");
+
+    for (int i = 0; i < BENCH_MAX_ARGS; i++)
+        argparse_add_argument(parser, NULL, g_names[i], ARG_INT, "value", false, NULL);
+
+    g_schema_size = argparse_save_schema(parser, NULL, 0);
+
+    /* malloc alignment satisfies the blob's 8-byte requirement */
+    if (!g_schema_size || !(g_schema = malloc(g_schema_size)) ||
+        argparse_save_schema(parser, g_schema, g_schema_size) != g_schema_size)
+        fail("save schema");
+
+    argparse_free(parser);
+}
+
+static void schema_run(void) {
+    ArgParser* parser = argparse_load_schema(g_schema, g_schema_size);
+    if (!parser) fail("load schema");
+    argparse_free(parser);
+}
+
+static void schema_teardown(void) {
+    free(g_schema);
+    g_schema = NULL;
+}
+
+/* ---- multi-tool start-up: one of many subcommands is used ---- */
+
+static char g_subcommand_names[BENCH_SUBCOMMANDS][16];
+
+static ArgParser* build_subcommand(void* user_data) {
+    (void)user_data;
+    ArgParser* parser = argparse_new("subcommand");
+
+    for (int i = 0; i < BENCH_SUBCOMMAND_ARGS; i++)
+        argparse_add_argument(parser, NULL, g_names[i], ARG_INT, "value", false, NULL);
+
+    return parser;
+}
+
+static void subcommand_setup(void) {
+    alloc_argv(4);
+    g_argv[1] = dup_string("tool7");
+    g_argv[2] = dup_string(g_names[3]);
+    g_argv[3] = dup_string("5");
+
+    for (int i = 0; i < BENCH_SUBCOMMANDS; i++)
+        snprintf(g_subcommand_names[i], sizeof(g_subcommand_names[i]), "tool%d", i);
+}
+
+static void subcommand_parse(bool eager) {
+    ArgParser* parser = argparse_new("bench");
+
+    for (int i = 0; i < BENCH_SUBCOMMANDS; i++)
+        argparse_add_subcommand(parser, g_subcommand_names[i], "tool", build_subcommand, NULL);
+
+    /* what a multi-tool without lazy children pays: every parser built up front */
+    if (eager) {
+        for (int i = 0; i < BENCH_SUBCOMMANDS; i++)
+            argparse_free(build_subcommand(NULL));
+    }
+
+    argparse_parse(parser, g_argc, g_argv);
+
+    ArgParser* child = argparse_get_subcommand(parser, NULL);
+    if (!child) fail("subcommand parse");
+
+    g_sink += argparse_get_int(child, g_names[3]);
+    argparse_free(parser);
+}
+
+static void sub_lazy_run(void) { subcommand_parse(false); }
+static void sub_eager_run(void) { subcommand_parse(true); }
+
+/* ---- argv parse with long lists ---- */
+
+static void list_argv_setup(void) {
+    alloc_argv(BENCH_LIST_VALUES + 2);
+    g_argv[1] = dup_string("-n");
+
+    for (int i = 0; i < BENCH_LIST_VALUES; i++)
+        g_argv[i + 2] = format_dup("%ld", (long)i * 7);
+}
+
+static void list_delimited_setup(void) {
+    alloc_argv(3);
+    g_argv[1] = dup_string("-n");
+
+    /* one comma-separated token */
+    size_t capacity = (size_t)BENCH_LIST_VALUES * 12 + 1, used = 0;
+    char* joined = (char*)malloc(capacity);
+    if (!joined) fail("malloc");
+
+    for (int i = 0; i < BENCH_LIST_VALUES; i++)
+        used += (size_t)snprintf(joined + used, capacity - used, i ? ",%d" : "%d", i * 7);
+
+    g_argv[2] = joined;
+}
+
+static void list_parse_run(void) {
+    ArgParser* parser = argparse_new("bench");
+    argparse_add_list_argument_ex(parser, "-n", "--numbers", ARG_INT_LIST,
+        "values", true, 0, ',');
+
+    argparse_parse(parser, g_argc, g_argv);
+    if (argparse_error_occurred()) fail("list parse");
+
+    g_sink += argparse_get_list_count(parser, "-n");
+    argparse_free(parser);
+}
+
+static bool stream_element(ArgHandle arg, const void* element, void* user_data) {
+    (void)arg;
+    *(long*)user_data += *(const int*)element;
+    return true;
+}
+
+static void list_stream_run(void) {
+    long total = 0;
+    ArgParser* parser = argparse_new("bench");
+    argparse_add_list_argument_cb(parser, "-n", "--numbers", ARG_INT_LIST,
+        "values", true, 0, ',', stream_element, &total);
+
+    argparse_parse(parser, g_argc, g_argv);
+    if (argparse_error_occurred()) fail("list stream");
+
+    g_sink += total;
+    argparse_free(parser);
+}
+
+/* ---- string list parse, copied or borrowed from argv ---- */
+
+static void string_argv_setup(void) {
+    alloc_argv(BENCH_STRING_VALUES + 2);
+    g_argv[1] = dup_string("-s");
+
+    for (int i = 0; i < BENCH_STRING_VALUES; i++)
+        g_argv[i + 2] = dup_string(g_names[i % BENCH_MAX_ARGS] + 2);
+}
+
+static void string_parse(unsigned flags) {
+    ArgParser* parser = argparse_new("bench");
+    argparse_set_flags(parser, flags);
+    argparse_add_list_argument(parser, "-s", "--strings", ARG_STRING_LIST, "strings", true);
+
+    argparse_parse(parser, g_argc, g_argv);
+    if (argparse_error_occurred()) fail("string parse");
+
+    g_sink += argparse_get_list_count(parser, "-s");
+    argparse_free(parser);
+}
+
+static void string_copy_run(void) { string_parse(0); }
+static void string_borrow_run(void) { string_parse(ARGPARSE_BORROW_ARGV); }
+
+/* ---- GNU --name=value heavy argv ---- */
+
+static void gnu_setup(void) {
+    alloc_argv(BENCH_GNU_TOKENS + 1);
+
+    for (int i = 0; i < BENCH_GNU_TOKENS; i++) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "--gnu%d=%d", i % BENCH_GNU_ARGS, i);
+        g_argv[i + 1] = dup_string(buffer);
+    }
+
+    for (int i = 0; i < BENCH_GNU_ARGS; i++)
+        snprintf(g_names[i], sizeof(g_names[i]), "--gnu%d", i);
+}
+
+static void gnu_run(void) {
+    ArgParser* parser = argparse_new("bench");
+
+    for (int i = 0; i < BENCH_GNU_ARGS; i++)
+        argparse_add_argument_ex(parser, NULL, g_names[i], ARG_INT, "value", false, NULL, '=');
+
+    argparse_parse(parser, g_argc, g_argv);
+    if (argparse_error_occurred()) fail("gnu parse");
+
+    argparse_free(parser);
+}
+
+static void gnu_teardown(void) {
+    free_argv();
+
+    for (int i = 0; i < BENCH_MAX_ARGS; i++)
+        snprintf(g_names[i], sizeof(g_names[i]), "--opt%d", i);
+}
+
+/* ---- abbreviated long options, resolved through the sorted name index ---- */
+
+static void abbrev_setup(void) {
+    g_parser = argparse_new("bench");
+    argparse_set_flags(g_parser, ARGPARSE_ALLOW_ABBREV);
+    alloc_argv(BENCH_ABBREV_ARGS + 1);
+
+    for (int i = 0; i < BENCH_ABBREV_ARGS; i++) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "--flag%04d-enabled", i);
+        argparse_add_argument(g_parser, NULL, buffer, ARG_BOOL, "flag", false, NULL);
+
+        /* "--flag0042-en" is a unique prefix of "--flag0042-enabled" */
+        buffer[strlen(buffer) - 5] = '\0';
+        g_argv[i + 1] = dup_string(buffer);
+    }
+}
+
+static void abbrev_run(void) {
+    argparse_parse(g_parser, g_argc, g_argv);
+    if (argparse_error_occurred()) fail("abbreviation parse");
+}
+
+static void abbrev_teardown(void) {
+    free_argv();
+    free_parser();
+}
+
+/* ---- required arguments, exclusive pairs and dependencies checked after the token walk ---- */
+
+static void rules_setup(void) {
+    g_parser = argparse_new("bench");
+    alloc_argv(BENCH_RULES_ARGS / 8 * 6 + 1);
+
+    /* per block of eight: one required, two exclusive pairs, one dependency, two plain */
+    for (int i = 0; i < BENCH_RULES_ARGS; i++)
+        argparse_add_argument(g_parser, NULL, g_names[i], ARG_INT, "value", i % 8 == 0, NULL);
+
+    int argc = 1;
+
+    for (int i = 0; i < BENCH_RULES_ARGS; i += 8) {
+        const char* first[] = { g_names[i + 1], g_names[i + 2] };
+        const char* second[] = { g_names[i + 3], g_names[i + 4] };
+
+        if (!argparse_add_exclusive_group(g_parser, first, 2, true) ||
+            !argparse_add_exclusive_group(g_parser, second, 2, false) ||
+            !argparse_add_dependency(g_parser, g_names[i + 5], g_names[i])) fail("rules setup");
+
+        g_argv[argc++] = dup_string(g_names[i]);
+        g_argv[argc++] = dup_string("1");
+        g_argv[argc++] = dup_string(g_names[i + 1]);
+        g_argv[argc++] = dup_string("2");
+        g_argv[argc++] = dup_string(g_names[i + 5]);
+        g_argv[argc++] = dup_string("3");
+    }
+}
+
+static void rules_run(void) {
+    argparse_parse(g_parser, g_argc, g_argv);
+    if (argparse_error_occurred()) fail("rules parse");
+}
+
+static void rules_teardown(void) {
+    free_argv();
+    free_parser();
+}
+
+/* ---- shell completion queries, answered from the sorted name index ---- */
+
+static FILE* g_null = NULL;
+static char* g_complete_words[] = { (char*)"-v", (char*)"--flag01" };
+
+static ArgParser* complete_parser(void) {
+    ArgParser* parser = argparse_new("bench");
+
+    for (int i = 0; i < BENCH_COMPLETE_ARGS; i++) {
+        char buffer[64];
+        snprintf(buffer, sizeof(buffer), "--flag%04d-enabled", i);
+        argparse_add_argument(parser, NULL, buffer, ARG_BOOL, "Enable one feature", false, NULL);
+    }
+
+    return parser;
+}
+
+static void complete_setup(void) {
+#ifdef _WIN32
+    g_null = fopen("NUL", "w");
+#else
+    g_null = fopen("/dev/null", "w");
+#endif
+    if (!g_null) fail("null device");
+    g_parser = complete_parser();
+}
+
+/* "--flag01" matches 100 of the names */
+static void complete_warm_run(void) {
+    if (argparse_complete(g_parser, 2, g_complete_words, g_null) != 100) fail("completion");
+}
+
+/* what one completion costs the shell: the program builds its parser, answers, exits */
+static void complete_cold_run(void) {
+    ArgParser* parser = complete_parser();
+    if (argparse_complete(parser, 2, g_complete_words, g_null) != 100) fail("completion");
+    argparse_free(parser);
+}
+
+static void complete_teardown(void) {
+    fclose(g_null);
+    g_null = NULL;
+    free_parser();
+}
+
+/* ---- many short argv vectors against one schema ---- */
+
+static char** g_batch_argv[BENCH_BATCH_VECTORS];
+static int g_batch_argc[BENCH_BATCH_VECTORS];
+
+static ArgParser* batch_parser(void) {
+    ArgParser* parser = argparse_new("bench");
+
+    for (int i = 0; i < BENCH_BATCH_ARGS; i++)
+        argparse_add_argument(parser, NULL, g_names[i], ARG_INT, "value", false, NULL);
+
+    argparse_add_argument(parser, "-s", "--string", ARG_STRING, "value", false, NULL);
+    argparse_add_list_argument(parser, "-n", "--numbers", ARG_INT_LIST, "values", false);
+    return parser;
+}
+
+static void batch_setup(void) {
+    g_parser = batch_parser();
+
+    for (int v = 0; v < BENCH_BATCH_VECTORS; v++) {
+        char** argv = (char**)calloc(10, sizeof(char*));
+        if (!argv) fail("calloc");
+
+        argv[0] = dup_string("bench");
+        argv[1] = dup_string(g_names[v % BENCH_BATCH_ARGS]);
+        argv[2] = format_dup("%ld", v);
+        argv[3] = dup_string("-s");
+        argv[4] = format_dup("name%ld", v);
+        argv[5] = dup_string("-n");
+        argv[6] = format_dup("%ld", v);
+        argv[7] = format_dup("%ld", v + 1);
+        argv[8] = format_dup("%ld", v + 2);
+
+        g_batch_argv[v] = argv;
+        g_batch_argc[v] = 9;
+    }
+}
+
+static bool batch_vector(ArgParser* parser, size_t index, ArgParseErrorCategory error,
+    void* user_data) {
+    (void)index;
+    (void)user_data;
+
+    if (error != APE_SUCCESS) fail("batch parse");
+    g_sink += argparse_get_list_count(parser, "-n");
+    return true;
+}
+
+static void batch_run(void) {
+    argparse_parse_batch(g_parser, BENCH_BATCH_VECTORS, g_batch_argc, g_batch_argv,
+        batch_vector, NULL);
+}
+
+/* what the batch replaces: a parser built, parsed and freed per vector */
+static void batch_fresh_run(void) {
+    for (int v = 0; v < BENCH_BATCH_VECTORS; v++) {
+        ArgParser* parser = batch_parser();
+
+        argparse_parse(parser, g_batch_argc[v], g_batch_argv[v]);
+        batch_vector(parser, (size_t)v, argparse_error_occurred()
+            ? argparse_error_get_category() : APE_SUCCESS, NULL);
+
+        argparse_free(parser);
+    }
+}
+
+static void batch_teardown(void) {
+    for (int v = 0; v < BENCH_BATCH_VECTORS; v++) {
+        for (int i = 0; i < g_batch_argc[v]; i++)
+            free(g_batch_argv[v][i]);
+        free(g_batch_argv[v]);
+    }
+
+    free_parser();
+}
+
+/* ---- getters in a hot loop ---- */
+
+static void getter_setup(void) {
+    g_parser = argparse_new("bench");
+
+    for (int i = 0; i < BENCH_GETTER_ARGS; i++)
+        argparse_add_argument(g_parser, NULL, g_names[i], ARG_INT, "value", false, NULL);
+
+    char* argv[] = { "bench", g_names[0], "42", NULL };
+    argparse_parse(g_parser, 3, argv);
+    if (argparse_error_occurred()) fail("getter parse");
+}
+
+static void getter_run(void) {
+    long total = 0;
+
+    for (int i = 0; i < BENCH_GETTER_CALLS; i++)
+        total += argparse_get_int(g_parser, g_names[i % BENCH_GETTER_ARGS]);
+
+    g_sink += total;
+}
+
+static ArgHandle g_handles[BENCH_GETTER_ARGS];
+
+static void handle_setup(void) {
+    getter_setup();
+
+    for (int i = 0; i < BENCH_GETTER_ARGS; i++)
+        g_handles[i] = argparse_get_handle(g_parser, g_names[i]);
+}
+
+static void handle_run(void) {
+    long total = 0;
+
+    for (int i = 0; i < BENCH_GETTER_CALLS; i++)
+        total += argparse_handle_get_int(g_handles[i % BENCH_GETTER_ARGS]);
+
+    g_sink += total;
+}
+
+/* ---- list extraction ---- */
+
+static void extract_setup(void) {
+    list_delimited_setup();
+
+    g_parser = argparse_new("bench");
+    argparse_add_list_argument_ex(g_parser, "-n", "--numbers", ARG_INT_LIST,
+        "values", true, 0, ',');
+    argparse_add_list_argument(g_parser, "-s", "--strings", ARG_STRING_LIST,
+        "strings", false);
+
+    /* append a string list after the numbers */
+    char** argv = (char**)calloc((size_t)BENCH_STRING_VALUES + 5, sizeof(char*));
+    if (!argv) fail("calloc");
+
+    argv[0] = g_argv[0];
+    argv[1] = g_argv[1];
+    argv[2] = g_argv[2];
+    argv[3] = "-s";
+
+    for (int i = 0; i < BENCH_STRING_VALUES; i++)
+        argv[i + 4] = g_names[i % BENCH_MAX_ARGS] + 2;
+
+    argparse_parse(g_parser, BENCH_STRING_VALUES + 4, argv);
+    free(argv);
+
+    if (argparse_error_occurred()) fail("extract parse");
+}
+
+static void extract_int_run(void) {
+    int* values = NULL;
+    g_sink += argparse_get_int_list(g_parser, "-n", &values);
+    argparse_free_int_list(&values);
+}
+
+static void extract_string_run(void) {
+    char** values = NULL;
+    int count = argparse_get_string_list(g_parser, "-s", &values);
+    g_sink += count;
+    argparse_free_string_list(&values, count);
+}
+
+static void extract_teardown(void) {
+    free_parser();
+    free_argv();
+}
+
+#ifdef ARGPARSE_STATS
+/* ---- parse statistics per token or list element, built with make STATS=1 bench ---- */
+
+static void print_stats(const char* name, const ArgParser* parser, long ops) {
+    const ArgParseStats* stats = argparse_get_stats(parser);
+    if (!stats) fail("stats");
+
+    double per = (double)ops;
+
+    printf("%-28s %8.2f lookups %8.2f compares %8.2f allocs %8.1f bytes %8.2f elements /op\n",
+        name, (double)stats->hash_lookups / per, (double)stats->string_compares / per,
+        (double)stats->allocations / per, (double)stats->bytes_copied / per,
+        (double)stats->list_elements / per);
+    printf("%-28s %8.1f gnu %8.1f lookup %8.1f convert %8.1f validate ns/op\n", "",
+        (double)stats->phase_ns[ARGPARSE_PHASE_GNU] / per,
+        (double)stats->phase_ns[ARGPARSE_PHASE_LOOKUP] / per,
+        (double)stats->phase_ns[ARGPARSE_PHASE_CONVERT] / per,
+        (double)stats->phase_ns[ARGPARSE_PHASE_VALIDATE] / per);
+}
+
+static void stats_run(void) {
+    gnu_setup();
+    ArgParser* parser = argparse_new("bench");
+
+    for (int i = 0; i < BENCH_GNU_ARGS; i++)
+        argparse_add_argument_ex(parser, NULL, g_names[i], ARG_INT, "value", false, NULL, '=');
+
+    argparse_parse(parser, g_argc, g_argv);
+    if (argparse_error_occurred()) fail("stats parse");
+
+    print_stats("stats/gnu-name=value", parser, BENCH_GNU_TOKENS);
+    argparse_free(parser);
+    gnu_teardown();
+
+    list_delimited_setup();
+    parser = argparse_new("bench");
+    argparse_add_list_argument_ex(parser, "-n", "--numbers", ARG_INT_LIST, "values", true, 0, ',');
+
+    argparse_parse(parser, g_argc, g_argv);
+    if (argparse_error_occurred()) fail("stats list parse");
+
+    print_stats("stats/int-list-comma", parser, BENCH_LIST_VALUES);
+    argparse_free(parser);
+    free_argv();
+}
+#endif
+
+static void run_bench(const Bench* bench) {
+    if (bench->setup) bench->setup();
+
+    /* warm-up, also catches errors before timing */
+    bench->run();
+
+    long iterations = 0;
+    unsigned long long allocations = g_allocations;
+    double start = now_ns(), elapsed = 0.0;
+
+    do {
+        bench->run();
+        iterations++;
+        elapsed = now_ns() - start;
+    } while (elapsed < BENCH_MIN_NS || iterations < 3);
+
+    allocations = g_allocations - allocations;
+    double ops = (double)iterations * (double)bench->ops;
+
+#ifdef ARGPARSE_BENCH_WRAP
+    printf("%-28s %14.1f ns/op %12.2f allocs/op %10ld iters\n", bench->name,
+        elapsed / ops, (double)allocations / ops, iterations);
+#else
+    (void)allocations;
+    printf("%-28s %14.1f ns/op %12s allocs/op %10ld iters\n", bench->name,
+        elapsed / ops, "n/a", iterations);
+#endif
+
+    if (bench->teardown) bench->teardown();
+}
+
+int main(int argc, char** argv) {
+    static const Bench benches[] = {
+        { "construct/8",            construct_8,          construct_run,      NULL,             1 },
+        { "construct/16",           construct_16,         construct_run,      NULL,             1 },
+        { "construct/256",          construct_256,        construct_run,      NULL,             1 },
+        { "construct/4096",         construct_4096,       construct_run,      NULL,             1 },
+        { "construct/schema-4096",  schema_setup,         schema_run,         schema_teardown,  1 },
+        { "parse/int-list-argv",    list_argv_setup,      list_parse_run,     free_argv,        BENCH_LIST_VALUES },
+        { "parse/int-list-comma",   list_delimited_setup, list_parse_run,     free_argv,        BENCH_LIST_VALUES },
+        { "parse/int-list-stream",  list_delimited_setup, list_stream_run,    free_argv,        BENCH_LIST_VALUES },
+        { "parse/str-list-copy",    string_argv_setup,    string_copy_run,    free_argv,        BENCH_STRING_VALUES },
+        { "parse/str-list-borrow",  string_argv_setup,    string_borrow_run,  free_argv,        BENCH_STRING_VALUES },
+        { "parse/gnu-name=value",   gnu_setup,            gnu_run,            gnu_teardown,     BENCH_GNU_TOKENS },
+        { "parse/subcommand-lazy",  subcommand_setup,     sub_lazy_run,       free_argv,        1 },
+        { "parse/subcommand-eager", subcommand_setup,     sub_eager_run,      free_argv,        1 },
+        { "parse/abbrev-1024",      abbrev_setup,         abbrev_run,         abbrev_teardown,  BENCH_ABBREV_ARGS },
+        { "parse/batch-reuse",      batch_setup,          batch_run,          batch_teardown,   BENCH_BATCH_VECTORS },
+        { "parse/batch-fresh",      batch_setup,          batch_fresh_run,    batch_teardown,   BENCH_BATCH_VECTORS },
+        { "parse/rules-1024",       rules_setup,          rules_run,          rules_teardown,   BENCH_RULES_ARGS },
+        { "complete/warm-1024",     complete_setup,       complete_warm_run,  complete_teardown, 1 },
+        { "complete/cold-1024",     complete_setup,       complete_cold_run,  complete_teardown, 1 },
+        { "get/int-hot-loop",       getter_setup,         getter_run,         free_parser,      BENCH_GETTER_CALLS },
+        { "get/int-handle",         handle_setup,         handle_run,         free_parser,      BENCH_GETTER_CALLS },
+        { "get/int-list",           extract_setup,        extract_int_run,    extract_teardown, 1 },
+        { "get/string-list",        extract_setup,        extract_string_run, extract_teardown, 1 }
+    };
+
+    /* optional substring filter, e.g. ./argparse_bench parse/ */
+    const char* filter = argc > 1 ? argv[1] : NULL;
+
+    for (int i = 0; i < BENCH_MAX_ARGS; i++)
+        snprintf(g_names[i], sizeof(g_names[i]), "--opt%d", i);
+
+    printf("%-28s %20s %22s %16s\n", "benchmark", "time", "allocations", "iterations");
+
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++) {
+        if (filter && !strstr(benches[i].name, filter))
+            continue;
+        run_bench(&benches[i]);
+    }
+
+#ifdef ARGPARSE_STATS
+    if (!filter || strstr("stats/", filter))
+        stats_run();
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -2,17 +2,62 @@
 #define ARGPARSE_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include "argparse_error.h"
+#include "argparse_fwd.h"
 #include "argparse_hash.h"
+#include "argparse_arena.h"
+#include "argparse_spec.h"
+#include "argparse_response.h"
+#include "argparse_schema.h"
+#include "argparse_stats.h"
+#include "argparse_rules.h"
+#include "argparse_complete.h"
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-    typedef enum ArgType ArgType;
-    typedef struct Argument Argument;
-    typedef struct ArgParser ArgParser;
+/* Parser flags, see argparse_set_flags(). */
+#define ARGPARSE_BORROW_ARGV 0x1u       /* String values point into argv instead of being copied */
+#define ARGPARSE_RESPONSE_FILES 0x2u    /* "@file" arguments are replaced by the words of file */
+#define ARGPARSE_ALLOW_ABBREV 0x4u      /* Unambiguous long-option prefixes select the option */
+#define ARGPARSE_COMPLETION 0x8u        /* "NAME __complete WORDS..." is answered as a completion query */
 
-    enum ArgType {
+    typedef union ArgScalar ArgScalar;
+    typedef struct ArgSource ArgSource;
+    typedef struct ArgSubcommand ArgSubcommand;
+
+    /* @brief Stable reference to one argument, valid until argparse_free(). */
+    typedef Argument* ArgHandle;
+
+    /**
+     * @brief Receives one element of a streaming list argument as soon as it is parsed.
+     * @param arg Argument the element belongs to
+     * @param element const int*, const double* or const char*, valid only during the call
+     * @param user_data Pointer given at registration
+     * @return false to reject the element and fail the parse (APE_VALIDATION).
+     */
+    typedef bool (*ArgListCallback)(ArgHandle arg, const void* element, void* user_data);
+
+    /**
+     * @brief Receives the outcome of one vector of argparse_parse_batch().
+     * @param parser Parser holding that vector's values, query it with the usual getters
+     * @param index Position of the vector in the batch
+     * @param error APE_SUCCESS, or the category of the error that ended its parse
+     * @param user_data Pointer given to argparse_parse_batch()
+     * @return false to stop the batch after this vector.
+     */
+    typedef bool (*ArgBatchCallback)(ArgParser* parser, size_t index, ArgParseErrorCategory error,
+        void* user_data);
+
+    /**
+     * @brief Builds the parser of one subcommand, only once argv actually names it.
+     * @param user_data Pointer given at registration
+     * @return New parser, owned and freed by the parent from then on; NULL on failure.
+     */
+    typedef ArgParser* (*ArgSubcommandBuilder)(void* user_data);
+
+    typedef enum ArgType {
         ARG_INT,
         ARG_DOUBLE,
         ARG_STRING,
@@ -20,39 +65,198 @@ extern "C" {
         ARG_INT_LIST,
         ARG_DOUBLE_LIST,
         ARG_STRING_LIST
+    } ArgType;
+
+    /* @brief Where argparse_add_source() looks up values missing from the command line. */
+    typedef enum ArgSourceKind {
+        ARGPARSE_SOURCE_ENV,    /* Environment variables PREFIX + NAME, e.g. APP_LOG_LEVEL */
+        ARGPARSE_SOURCE_FILE    /* KEY=VALUE config file, e.g. log-level = debug */
+    } ArgSourceKind;
+
+    /* @brief Registration default of a scalar, kept for argparse_reset(). */
+    union ArgScalar {
+        int as_int;
+        double as_double;
+        bool as_bool;
+        char* as_string;            /* Owned default copy, the caller's pointer when bound */
     };
 
+    /*
+     * Hot fields first: name lookups, the token walk and value storage only touch the first
+     * 64 bytes. Names and help point into the parser's intern pool (or a static spec table).
+     */
     struct Argument {
         char* short_name;
         char* long_name;
+        void* value;                /* &scalar, the bound target, a string or a list buffer */
+        Argument* next;
+        size_t index;
+        size_t list_count;
 
-        char* help;
         ArgType type;
-
-        void* value;
+        unsigned char suffix;
+        unsigned char delimiter;
         bool required;
         bool set;
+        bool is_list;
+        bool resolved;              /* Fallback sources were consulted */
+        bool borrowed;
+        bool from_spec;
 
-        unsigned char suffix;
-        unsigned char delimiter;
+        /* value storage of unbound scalars */
+        ArgScalar scalar;
+        size_t list_capacity;
 
-        bool is_list;
-        Argument* next;
+        void* target;
+        ArgListCallback callback;
+        void* callback_data;
+
+        /* fallback sources are consulted once, on the first read of an unset value */
+        ArgParser* owner;
+
+        /* value restored by argparse_reset() */
+        ArgScalar initial;
+        char* help;
+    };
+
+    struct ArgSource {
+        ArgSourceKind kind;
+        char* prefix;               /* Environment variable prefix (ARGPARSE_SOURCE_ENV) */
+        ArgWords* entries;          /* Key and value words of the file (ARGPARSE_SOURCE_FILE) */
+        const char** keys;          /* Keys sorted for binary search, the value follows each key */
+        size_t key_count;
+        ArgSource* next;
+    };
+
+    struct ArgSubcommand {
+        char* name;
+        char* help;
+        ArgSubcommandBuilder builder;
+        void* user_data;
+        ArgParser* parser;          /* Built on first dispatch, NULL until then */
+        ArgSubcommand* next;
+    };
+
+    struct ArgSpec {
+        const char* short_name;
+        const char* long_name;
+
+        ArgType type;
+        const char* help;
+
+        bool required;
+        const void* default_value;
+
+        char suffix;
+        char delimiter;
     };
 
     struct ArgParser {
         Argument* arguments;
+        Argument* tail;
         char* program_name;
 
         char* description;
         bool help_requested;
         bool help_added;
+        bool completion_requested;  /* The last argparse_parse() answered a completion query */
 
         ArgHashTable* hash_table;
         size_t argument_count;
         bool hash_enabled;
+
+        /* sorted names for abbreviations and suggestions, built on the first miss */
+        ArgNameIndex* name_index;
+
+        ArgArena* arena;
+        ArgHashSeedPolicy seed_policy;
+        unsigned flags;
+
+        const ArgSpecIndex* spec_index;
+        ArgSpecIndex* owned_spec_index;
+        Argument* spec_arguments;
+        Argument* spec_tail;
+
+        /* other arguments, packed in registration order, and their interned names and help */
+        ArgArena* nodes;
+        ArgInternPool* names;
+
+        /* distinct GNU suffix characters, NUL-terminated for strpbrk */
+        char suffix_chars[256];
+
+        /* argument copies of an ArgParseResult view, NULL in a schema */
+        Argument* overlay;
+
+        /* string values point into the input instead of being copied */
+        bool borrow_strings;
+        ArgArena* string_pool;
+
+        /* response files kept alive for borrowed values */
+        ArgWords* response_words;
+
+        /* rendered help, rebuilt after arguments or the program name change */
+        char* help_text;
+        size_t help_length;
+
+        /* fallback sources in lookup order, shared read-only with result views */
+        ArgSource* sources;
+        ArgSource* sources_tail;
+
+        /* registered subcommands and the one named by the last parse */
+        ArgSubcommand* subcommands;
+        ArgSubcommand* subcommands_tail;
+        ArgSubcommand* active_subcommand;
+
+        /* parse counters, only allocated in ARGPARSE_STATS builds */
+        ArgParseStats* stats;
+
+        /* token storage reused by parses longer than the stack buffer */
+        void* token_buffer;
+        size_t token_capacity;
+
+        /* inside argparse_parse_batch(): errors go to the callback instead of exiting */
+        bool batch;
+
+        /* per-index flags, a result view owns its set_bits and shares the rest read-only */
+        ArgBits* set_bits;
+        ArgBits* required_bits;
+        ArgBits* eager_bits;        /* Fallbacks resolved by every parse */
+        size_t bit_words;           /* Words in each bitset */
+
+        /* checked after required arguments, most recently added first */
+        ArgGroup* groups;
+        ArgDependency* dependencies;
     };
 
+/* Capacity of the error message stored in an ArgParseResult. */
+#define ARGPARSE_RESULT_MESSAGE_SIZE 256
+
+    /* @brief Values and outcome of one argparse_parse_r() call, independent of other calls. */
+    typedef struct ArgParseResult ArgParseResult;
+
+    struct ArgParseResult {
+        ArgParser view;             /* Private: schema header over per-result argument copies */
+        ArgParseErrorCategory error;
+        int error_errno;
+        bool help_requested;
+        char error_message[ARGPARSE_RESULT_MESSAGE_SIZE];
+    };
+
+/* Static table entry for argparse_new_from_spec(); strings must outlive the parser. */
+#define ARGPARSE_SPEC(short_name, long_name, type, help, required) \
+    { (short_name), (long_name), (type), (help), (required), NULL, 0, 0 }
+
+/* ARGPARSE_SPEC with a default value pointer (type-specific, as in argparse_add_argument). */
+#define ARGPARSE_SPEC_DEFAULT(short_name, long_name, type, help, required, default_value) \
+    { (short_name), (long_name), (type), (help), (required), (default_value), 0, 0 }
+
+/* ARGPARSE_SPEC with GNU-style suffix and list delimiter (0 for none / space). */
+#define ARGPARSE_SPEC_EX(short_name, long_name, type, help, required, suffix, delimiter) \
+    { (short_name), (long_name), (type), (help), (required), NULL, (suffix), (delimiter) }
+
+/* Number of entries in a static ArgSpec array. */
+#define ARGPARSE_SPEC_COUNT(table) (sizeof(table) / sizeof((table)[0]))
+
     /** 
      * @brief Safe strdup() alternative with overflow protection and error reporting.
      * @param str Source string to duplicate. May be NULL (returns NULL)
@@ -68,12 +272,105 @@ extern "C" {
      */
     ArgParser* argparse_new(const char* description);
 
+    /**
+     * @brief Creates a parser whose internal allocations all come from one bump arena.
+     * @param description Brief program description for help output (can be NULL)
+     * @return Pointer to new parser instance on success or NULL, if memory allocation fails.
+     * @note Behaves like argparse_new(); argparse_free() then releases the whole arena at once.
+     */
+    ArgParser* argparse_new_with_arena(const char* description);
+
+    /**
+     * @brief Creates a parser from a static argument table without copying it.
+     * @param description Brief program description for help output (can be NULL)
+     * @param specs Static table declared with ARGPARSE_SPEC entries (must outlive the parser)
+     * @param count Number of entries, usually ARGPARSE_SPEC_COUNT(specs)
+     * @param index Perfect hash generated by argparse_spec_index_write(), or NULL to build one now
+     * @return Pointer to new parser instance on success or NULL on error.
+     * @note Lookups for table names are a single probe; "-h"/"--help" is added implicitly.
+     */
+    ArgParser* argparse_new_from_spec(const char* description, const ArgSpec* specs,
+        size_t count, const ArgSpecIndex* index);
+
     /**
      * @brief Releases all memory associated with a parser instance. 
      * @param parser Parser to free (NULL-safe)
      */
     void argparse_free(ArgParser* parser);
 
+    /**
+     * @brief Selects how the parser seeds its argument hash table.
+     * @param parser Parser instance
+     * @param policy ARGPARSE_SEED_SECURE (default), ARGPARSE_SEED_PROCESS or ARGPARSE_SEED_FIXED
+     * @note Takes effect when the table is built, i.e. call it before the
+     *       ARGPARSE_HASH_THRESHOLD-th argument is added.
+     */
+    void argparse_set_seed_policy(ArgParser* parser, ArgHashSeedPolicy policy);
+
+    /**
+     * @brief Replaces the parser flags.
+     * @param parser Parser instance
+     * @param flags Bitwise OR of ARGPARSE_* flags, 0 restores the defaults
+     * @note With ARGPARSE_BORROW_ARGV, ARG_STRING and ARG_STRING_LIST values are pointers into
+     *       argv, which must then outlive the parser (the usual case for main's argv).
+     * @note With ARGPARSE_RESPONSE_FILES, every argv entry "@path" before "--" is replaced by the
+     *       words of that file, split like argparse_parse_buffer() input. Files are not nested.
+     * @note With ARGPARSE_ALLOW_ABBREV, "--verb" selects "--verbose" when no other long name
+     *       starts with it (also in the GNU "--verb=value" form); an ambiguous prefix fails.
+     * @note With ARGPARSE_COMPLETION, argparse_parse() writes the candidates for a "__complete"
+     *       argv[1] to stdout instead of parsing, see argparse_completion_requested().
+     */
+    void argparse_set_flags(ArgParser* parser, unsigned flags);
+
+    /**
+     * @brief Adds a fallback for values not given on the command line.
+     * @param parser Target parser instance
+     * @param kind ARGPARSE_SOURCE_ENV or ARGPARSE_SOURCE_FILE
+     * @param location Variable prefix (may be "") for ARGPARSE_SOURCE_ENV, file path for
+     *        ARGPARSE_SOURCE_FILE
+     * @return - true on success
+     * @return - false on invalid parameters (APE_INTERNAL), unreadable file (APE_VALIDATION)
+     *           or memory failure (APE_MEMORY)
+     * @note Sources are consulted in the order they were added, after argv and before the
+     *       default: add the environment before the file for the usual argv > env > file order.
+     * @note An argument is looked up by its long name without dashes (else its short name).
+     *       Environment names are upper-cased with '-' turned into '_'; file keys match with
+     *       '-' and '_' interchangeable, the last assignment of a key wins.
+     * @note The file is read and indexed here. A value is only converted when a getter first
+     *       reads the unset argument, conversion errors are reported by that getter; required,
+     *       bound, streaming and group or dependency arguments are resolved at the end of
+     *       each parse instead.
+     */
+    bool argparse_add_source(ArgParser* parser, ArgSourceKind kind, const char* location);
+
+    /**
+     * @brief Declares arguments that exclude each other.
+     * @param parser Target parser instance
+     * @param names Short or long names of the members
+     * @param count Number of names
+     * @param required Whether one member must be given
+     * @return - true on success
+     * @return - false on invalid parameters (APE_INTERNAL), an unknown name (APE_CONFIG)
+     *           or memory failure (APE_MEMORY)
+     * @note Parsing fails with APE_VALIDATION when two members are given and, for a required
+     *       group, with APE_REQUIRED when none is. Values from fallback sources count as given.
+     */
+    bool argparse_add_exclusive_group(ArgParser* parser, const char* const* names, size_t count,
+        bool required);
+
+    /**
+     * @brief Declares that one argument is only valid together with another.
+     * @param parser Target parser instance
+     * @param name Short or long name of the dependent argument
+     * @param required_name Name of the argument it requires
+     * @return - true on success
+     * @return - false on invalid parameters (APE_INTERNAL), an unknown or identical name
+     *           (APE_CONFIG) or memory failure (APE_MEMORY)
+     * @note Parsing fails with APE_REQUIRED when name is given without required_name.
+     *       Call once per requirement; requirements are not transitive.
+     */
+    bool argparse_add_dependency(ArgParser* parser, const char* name, const char* required_name);
+
     /**
      * @brief Defines a command-line argument with basic configuration.
      * @param parser Target parser instance
@@ -112,6 +409,115 @@ extern "C" {
     void argparse_add_list_argument_ex(ArgParser* parser, const char* short_name, const char* long_name,
         ArgType list_type, const char* help, bool required, char suffix, char delimiter);
 
+    /**
+     * @brief argparse_add_argument() returning a handle for lookup-free value access.
+     * @param All parameters from argparse_add_argument function
+     * @return - Handle to the new argument
+     * @return - NULL on error, or for "-h"/"--help" which the parser already defines
+     */
+    ArgHandle argparse_add_argument_handle(ArgParser* parser, const char* short_name,
+        const char* long_name, ArgType type, const char* help, bool required, void* default_value);
+
+    /**
+     * @brief argparse_add_argument_ex() returning a handle.
+     * @param All parameters from argparse_add_argument_ex function
+     * @return Handle to the new argument, NULL on error.
+     */
+    ArgHandle argparse_add_argument_ex_handle(ArgParser* parser, const char* short_name,
+        const char* long_name, ArgType type, const char* help, bool required, void* default_value,
+        char suffix);
+
+    /**
+     * @brief argparse_add_list_argument_ex() returning a handle.
+     * @param All parameters from argparse_add_list_argument_ex function
+     * @return Handle to the new argument, NULL on error.
+     */
+    ArgHandle argparse_add_list_argument_handle(ArgParser* parser, const char* short_name,
+        const char* long_name, ArgType list_type, const char* help, bool required, char suffix,
+        char delimiter);
+
+    /**
+     * @brief Defines a scalar argument whose parsed value is stored straight into caller memory.
+     * @param All parameters from argparse_add_argument function, except default_value
+     * @param target int*, double* or bool* written on parse (its current contents act as the
+     *        default); for ARG_STRING a const char** pointed at the parser-owned string
+     * @return Handle to the new argument, NULL on error (list types cannot be bound).
+     * @note Target storage must outlive the parser; fields (&config.port) work the same way.
+     */
+    ArgHandle argparse_add_argument_bind(ArgParser* parser, const char* short_name,
+        const char* long_name, ArgType type, const char* help, bool required, void* target);
+
+    /**
+     * @brief argparse_add_argument_bind() with GNU-style suffix support.
+     * @param All parameters from argparse_add_argument_bind function
+     * @param suffix Delimiter character between argument name and value (e.g., '=')
+     * @return Handle to the new argument, NULL on error.
+     */
+    ArgHandle argparse_add_argument_bind_ex(ArgParser* parser, const char* short_name,
+        const char* long_name, ArgType type, const char* help, bool required, void* target,
+        char suffix);
+
+    /**
+     * @brief Type-checked shorthands for argparse_add_argument_bind().
+     * @param target Caller-owned variable receiving the parsed value
+     * @return Handle to the new argument, NULL on error.
+     */
+    ArgHandle argparse_bind_int(ArgParser* parser, const char* short_name, const char* long_name,
+        const char* help, bool required, int* target);
+    ArgHandle argparse_bind_double(ArgParser* parser, const char* short_name, const char* long_name,
+        const char* help, bool required, double* target);
+    ArgHandle argparse_bind_bool(ArgParser* parser, const char* short_name, const char* long_name,
+        const char* help, bool required, bool* target);
+    ArgHandle argparse_bind_string(ArgParser* parser, const char* short_name, const char* long_name,
+        const char* help, bool required, const char** target);
+
+    /**
+     * @brief Defines a list argument whose elements are streamed to a callback instead of stored.
+     * @param All parameters from argparse_add_list_argument_ex function
+     * @param callback Invoked once per element, in command-line order
+     * @param user_data Passed through to the callback
+     * @return Handle to the new argument, NULL on error.
+     * @note Memory stays O(1) in the number of elements: the list getters report no values,
+     *       argparse_handle_is_set() tells whether any were given.
+     */
+    ArgHandle argparse_add_list_argument_cb(ArgParser* parser, const char* short_name,
+        const char* long_name, ArgType list_type, const char* help, bool required, char suffix,
+        char delimiter, ArgListCallback callback, void* user_data);
+
+    /**
+     * @brief Resolves a name to a handle once, e.g. for parsers built from a spec table.
+     * @param parser Parser instance
+     * @param name Argument name (short or long form)
+     * @return Handle, or NULL if the name is not defined.
+     */
+    ArgHandle argparse_get_handle(ArgParser* parser, const char* name);
+
+    /**
+     * @brief Registers a subcommand whose parser is only built when argv names it.
+     * @param parser Parent parser
+     * @param name Subcommand name as typed on the command line (e.g. "build")
+     * @param help Description for the help output (can be NULL)
+     * @param builder Creates the child parser on first use
+     * @param user_data Passed through to the builder
+     * @return - true on success
+     * @return - false on invalid parameters (APE_INTERNAL), a duplicate name (APE_CONFIG) or
+     *           memory failure (APE_MEMORY)
+     * @note The first plain value that names a subcommand ends the parent's options: the
+     *       parent checks its required arguments, then the child parses the rest of argv in
+     *       place, with the subcommand name as its argv[0]. argparse_parse_r() rejects
+     *       subcommands (APE_CONFIG), building a child would modify the shared parser.
+     */
+    bool argparse_add_subcommand(ArgParser* parser, const char* name, const char* help,
+        ArgSubcommandBuilder builder, void* user_data);
+
+    /**
+     * @brief Returns the subcommand selected by the last parse.
+     * @param parser Parent parser
+     * @param name Receives the subcommand name (can be NULL)
+     * @return Child parser holding the subcommand's values, NULL if none was named.
+     */
+    ArgParser* argparse_get_subcommand(ArgParser* parser, const char** name);
+
     /**
      * @brief Parses command-line arguments according to defined specifications.
      * @param parser Configured parser instance
@@ -120,12 +526,114 @@ extern "C" {
      */
     void argparse_parse(ArgParser* parser, int argc, char** argv);
 
+    /**
+     * @brief Parses a flat command line (arguments only, no program name) without an argv array.
+     * @param parser Configured parser instance
+     * @param buf Command text, split on whitespace with '...', "..." and backslash quoting
+     * @param len Number of bytes in buf (need not be NUL-terminated)
+     * @note The buffer is copied once and split in place; string values are slices of that
+     *       copy, which is kept until argparse_reset() or argparse_free().
+     */
+    void argparse_parse_buffer(ArgParser* parser, const char* buf, size_t len);
+
+    /**
+     * @brief Returns every argument to its registration state so the parser can parse again.
+     * @param parser Parser instance (NULL-safe)
+     * @note Scalars and bound variables get their defaults back and lists are emptied with
+     *       their capacity kept; names, hash table and help text are untouched. Response files,
+     *       buffer copies and the string values of arena parsers are released, so a parse and
+     *       reset loop runs in constant memory. Built subcommands are reset.
+     */
+    void argparse_reset(ArgParser* parser);
+
+    /**
+     * @brief Parses many argument vectors against the same parser, one callback per vector.
+     * @param parser Configured parser instance
+     * @param count Number of vectors
+     * @param argcs Argument count of each vector
+     * @param argvs Each vector, with the program name in argv[0] like main()'s
+     * @param callback Called after each parse while its values are in the parser
+     * @param user_data Passed to the callback
+     * @return Number of vectors parsed, less than count when the callback stopped the batch.
+     * @note Each vector starts from argparse_reset(). Errors never exit or print help, they are
+     *       handed to the callback (the thread's error state holds the message), and a vector
+     *       without arguments is a plain parse rather than a help request. String values point
+     *       into the vectors as with ARGPARSE_BORROW_ARGV, so a warmed-up batch does not allocate.
+     */
+    size_t argparse_parse_batch(ArgParser* parser, size_t count, const int* argcs, char** const* argvs,
+        ArgBatchCallback callback, void* user_data);
+
+    /**
+     * @brief Reentrant parse: values and errors go to a new result, the parser is only read.
+     * @param parser Fully configured parser, shared between threads without locking
+     * @param argc Argument count
+     * @param argv Argument vector (must outlive the result)
+     * @return - Result to query with argparse_result_* and free with argparse_result_free()
+     * @return - NULL on invalid parameters or allocation failure
+     * @note Never prints help or exits; a missing argv[1] is not treated as a help request.
+     *       The parser must not be modified or freed while results are in use.
+     */
+    ArgParseResult* argparse_parse_r(const ArgParser* parser, int argc, char** argv);
+
+    /**
+     * @brief Releases a result and every value it owns.
+     * @param result Result to free (NULL-safe)
+     */
+    void argparse_result_free(ArgParseResult* result);
+
+    /**
+     * @brief Looks up an argument of a result, for use with the argparse_handle_get_* getters.
+     * @param result Parse result
+     * @param name Argument name (short or long form)
+     * @return Handle into the result, or NULL if the name is not defined.
+     */
+    ArgHandle argparse_result_get_handle(ArgParseResult* result, const char* name);
+
+    /**
+     * @brief Translates a schema handle (argparse_add_*_handle) into the given result, O(1).
+     * @param result Parse result
+     * @param handle Handle obtained from the parser the result was parsed with
+     * @return Handle into the result, or NULL if either argument is NULL.
+     */
+    ArgHandle argparse_result_handle(const ArgParseResult* result, ArgHandle handle);
+
+    /**
+     * @brief Reports the outcome of the parse that produced the result.
+     * @param result Parse result
+     * @return APE_SUCCESS, APE_HELP_REQUESTED or the error category (APE_INTERNAL for NULL).
+     */
+    ArgParseErrorCategory argparse_result_error(const ArgParseResult* result);
+
+    /**
+     * @brief Formatted message of the parse error, empty on success.
+     * @param result Parse result
+     * @return Message owned by the result.
+     */
+    const char* argparse_result_error_message(const ArgParseResult* result);
+
+    /**
+     * @brief Checks whether "-h"/"--help" appeared on the command line.
+     * @param result Parse result
+     * @return true if help was requested.
+     */
+    bool argparse_result_help_requested(const ArgParseResult* result);
+
     /**
      * @brief Prints formatted usage information to stdout.
      * @param parser Parser instance (NULL-safe)
+     * @note The text is rendered once, cached, and written with a single fwrite().
      */
     void argparse_print_help(ArgParser* parser);
 
+    /**
+     * @brief Renders the help text of argparse_print_help() into memory.
+     * @param parser Parser instance
+     * @param buf Destination, always NUL-terminated when len > 0 (may be NULL if len is 0)
+     * @param len Size of buf in bytes
+     * @return Full length of the help text; a result >= len means it was truncated.
+     */
+    size_t argparse_format_help(ArgParser* parser, char* buf, size_t len);
+
     /**
      * @brief Retrieves boolean argument value.
      * @param parser Parser instance
@@ -158,6 +666,24 @@ extern "C" {
      */
     const char* argparse_get_string(ArgParser* parser, const char* name);
 
+    /**
+     * @brief Handle counterparts of the getters above. They do not hash, compare names or touch
+     *        the error state; a NULL handle, wrong type or unset argument yields 0/false/NULL.
+     * @param handle Handle from argparse_add_*_handle() or argparse_get_handle()
+     * @return Argument value.
+     */
+    bool argparse_handle_get_bool(ArgHandle handle);
+    int argparse_handle_get_int(ArgHandle handle);
+    double argparse_handle_get_double(ArgHandle handle);
+    const char* argparse_handle_get_string(ArgHandle handle);
+
+    /**
+     * @brief Reports whether the argument was given on the command line.
+     * @param handle Argument handle (NULL-safe)
+     * @return true if the argument was set by the last parse.
+    */
+    bool argparse_handle_is_set(ArgHandle handle);
+
     /**
      * @brief Returns number of elements in a list argument.
      * @param parser Parser instance
@@ -193,6 +719,47 @@ extern "C" {
      */
     int argparse_get_string_list(ArgParser* parser, const char* name, char*** values);
 
+    /**
+     * @brief Borrows integer list storage without copying.
+     * @param parser Parser instance
+     * @param name List argument name
+     * @param values Pointer to receive a read-only view into parser-owned storage
+     * @return Number of elements in the view (0 on error).
+     * @note The view stays valid until the next argparse_parse() or argparse_free(); do not free it.
+     */
+    int argparse_get_int_list_view(ArgParser* parser, const char* name, const int** values);
+
+    /**
+     * @brief Borrows double list storage without copying.
+     * @param parser Parser instance
+     * @param name List argument name
+     * @param values Pointer to receive a read-only view into parser-owned storage
+     * @return Number of elements in the view (0 on error).
+     * @note The view stays valid until the next argparse_parse() or argparse_free(); do not free it.
+     */
+    int argparse_get_double_list_view(ArgParser* parser, const char* name, const double** values);
+
+    /**
+     * @brief Borrows string list storage without copying the array or the strings.
+     * @param parser Parser instance
+     * @param name List argument name
+     * @param values Pointer to receive a read-only view into parser-owned storage
+     * @return Number of elements in the view (0 on error).
+     * @note The view stays valid until the next argparse_parse() or argparse_free(); do not free it.
+     */
+    int argparse_get_string_list_view(ArgParser* parser, const char* name, const char* const** values);
+
+    /**
+     * @brief Handle counterparts of the list count and view getters, with the same lifetime rules.
+     * @param handle List argument handle (NULL-safe)
+     * @param values Pointer to receive the view (may be NULL to query the count only)
+     * @return Number of elements (0 if unset, empty or of another type).
+     */
+    int argparse_handle_get_list_count(ArgHandle handle);
+    int argparse_handle_get_int_list_view(ArgHandle handle, const int** values);
+    int argparse_handle_get_double_list_view(ArgHandle handle, const double** values);
+    int argparse_handle_get_string_list_view(ArgHandle handle, const char* const** values);
+
     /** 
      * @brief Frees memory allocated by argparse_get_int_list().
      * @param values Pointer to array pointer (set to NULL after free)
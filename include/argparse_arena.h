@@ -0,0 +1,99 @@
+#ifndef ARGPARSE_ARENA_H
+#define ARGPARSE_ARENA_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ARGPARSE_ARENA_BLOCK_SIZE 16384
+
+    /* @brief Single chunk of arena memory, chained from the newest block. */
+    typedef struct ArgArenaBlock ArgArenaBlock;
+
+    /* @brief Bump allocator whose memory is released all at once. */
+    typedef struct ArgArena ArgArena;
+
+    struct ArgArenaBlock {
+        struct ArgArenaBlock* next; /* Previously filled block */
+        size_t capacity;            /* Usable bytes in this block */
+        size_t used;                /* Bytes handed out so far */
+    };
+
+    struct ArgArena {
+        ArgArenaBlock* head;        /* Block currently being filled */
+        size_t block_size;          /* Default capacity for new blocks */
+        void* last_alloc;           /* Most recent allocation (in-place growth) */
+        ArgArenaBlock* spare;       /* Emptied blocks reused before new ones are allocated */
+        ArgArenaBlock* first;       /* Block holding this header, freed last and never made spare */
+    };
+
+    /**
+     * @brief Creates a new arena.
+     * @param block_size Default block capacity in bytes (0 selects ARGPARSE_ARENA_BLOCK_SIZE)
+     * @return - Pointer to the arena on success
+     * @return - NULL on memory allocation failure (sets APE_MEMORY error)
+    */
+    ArgArena* argparse_arena_create_internal(size_t block_size);
+
+    /**
+     * @brief Releases every block owned by the arena, including the arena itself.
+     * @param arena Arena to destroy (NULL-safe)
+    */
+    void argparse_arena_destroy_internal(ArgArena* arena);
+
+    /**
+     * @brief Invalidates every allocation but keeps the blocks for the allocations to come.
+     * @param arena Arena to rewind (NULL-safe)
+    */
+    void argparse_arena_reset_internal(ArgArena* arena);
+
+    /**
+     * @brief Allocates memory, from the arena when one is given or from the heap otherwise.
+     * @param arena Arena to allocate from (NULL selects malloc)
+     * @param size Number of bytes
+     * @return Suitably aligned memory, or NULL on failure.
+    */
+    void* argparse_arena_malloc(ArgArena* arena, size_t size);
+
+    /**
+     * @brief Zero-initialized variant of argparse_arena_malloc().
+     * @param arena Arena to allocate from (NULL selects calloc)
+     * @param count Number of elements
+     * @param size Size of each element
+     * @return Zeroed memory, or NULL on failure or overflow.
+    */
+    void* argparse_arena_calloc(ArgArena* arena, size_t count, size_t size);
+
+    /**
+     * @brief Resizes a block obtained from argparse_arena_malloc().
+     * @param arena Owning arena (NULL selects realloc)
+     * @param ptr Block to resize (may be NULL)
+     * @param old_size Current size of the block, needed to copy arena memory
+     * @param new_size Requested size
+     * @return Resized memory, or NULL on failure (original block left untouched).
+    */
+    void* argparse_arena_realloc(ArgArena* arena, void* ptr, size_t old_size, size_t new_size);
+
+    /**
+     * @brief Releases a block; a no-op for arena memory, which is freed with the arena.
+     * @param arena Owning arena (NULL selects free)
+     * @param ptr Block to release (NULL-safe)
+    */
+    void argparse_arena_free(ArgArena* arena, void* ptr);
+
+    /**
+     * @brief Duplicates a string into arena or heap memory.
+     * @param arena Arena to allocate from (NULL selects the heap)
+     * @param str Source string (may be NULL, returns NULL)
+     * @return Copy of the string, or NULL on failure.
+    */
+    char* argparse_arena_strdup(ArgArena* arena, const char* str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef ARGPARSE_COMPLETE_H
+#define ARGPARSE_COMPLETE_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "argparse_fwd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* First argument that turns argparse_parse() into a completion query under ARGPARSE_COMPLETION. */
+#define ARGPARSE_COMPLETE_COMMAND "__complete"
+
+    /* @brief Shells argparse_print_completion() writes scripts for. */
+    typedef enum ArgShell {
+        ARGPARSE_SHELL_BASH,    /* complete -F, source it from ~/.bashrc */
+        ARGPARSE_SHELL_ZSH,     /* compdef function, source it or put it on $fpath */
+        ARGPARSE_SHELL_FISH     /* complete -c, e.g. ~/.config/fish/completions/NAME.fish */
+    } ArgShell;
+
+    /**
+     * @brief Prints a completion script for the program to stdout.
+     * @param parser Parser instance, its program name (argv[0] of the last parse) names the command
+     * @param shell ARGPARSE_SHELL_BASH, ARGPARSE_SHELL_ZSH or ARGPARSE_SHELL_FISH
+     * @return - true on success
+     * @return - false on invalid parameters (APE_INTERNAL) or no program name yet (APE_CONFIG)
+     * @note The script runs "NAME __complete WORDS..." for every completion, so it stays valid
+     *       when arguments or subcommands change; it falls back to file names when the program
+     *       offers nothing (e.g. after an option that takes a value). The program answers that
+     *       with ARGPARSE_COMPLETION set, or by calling argparse_complete() itself.
+     */
+    bool argparse_print_completion(ArgParser* parser, ArgShell shell);
+
+    /**
+     * @brief Writes the candidates for the last word of a partial command line.
+     * @param parser Parser of the program
+     * @param count Number of words
+     * @param words Command line after the program name, the last word (possibly "") is completed
+     * @param out Stream receiving one "candidate<TAB>help" line per match (help may be absent)
+     * @return Number of candidates written.
+     * @note A word starting with '-' completes option names from the sorted name index, any
+     *       other word the subcommand names. Words naming a subcommand hand the rest of
+     *       the line to its parser, which is built when needed. Nothing is parsed or validated.
+     * @note With ARGPARSE_COMPLETION, argparse_parse() answers "NAME __complete WORDS..." this
+     *       way on stdout, unless a subcommand of that name is registered.
+     */
+    size_t argparse_complete(ArgParser* parser, int count, char** words, FILE* out);
+
+    /**
+     * @brief Tells whether the last argparse_parse() answered a completion query.
+     * @param parser Parser instance (NULL-safe)
+     * @return true when candidates were written instead of parsing; the program should exit
+     *         with EXIT_SUCCESS without further output, no argument holds a parsed value.
+     */
+    bool argparse_completion_requested(const ArgParser* parser);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -12,12 +12,7 @@ extern "C" {
     /**
      * @brief Categorizes all possible errors in the argparse library, each with specific semantics and severity.
     */
-    typedef enum ArgParseErrorCategory ArgParseErrorCategory;
-
-    /* @brief Complete error context structure containing all error information. */
-    typedef struct ArgParseError ArgParseError;
-
-    enum ArgParseErrorCategory {
+    typedef enum ArgParseErrorCategory {
         APE_SUCCESS = 0,      /* Operation completed successfully. */
         APE_MEMORY,           /* Memory allocation failure. */
         APE_SYNTAX,           /* Command line syntax error. */
@@ -30,7 +25,10 @@ extern "C" {
         APE_UNKNOWN_ARG,      /* Unknown argument provided. */
         APE_DUPLICATE,        /* Duplicate argument definition. */
         APE_HELP_REQUESTED    /* Help requested (non-fatal). */
-    };
+    } ArgParseErrorCategory;
+
+    /* @brief Complete error context structure containing all error information. */
+    typedef struct ArgParseError ArgParseError;
 
     struct ArgParseError {
         ArgParseErrorCategory category;
@@ -47,8 +45,9 @@ extern "C" {
      * @param errno_val Standard C errno value to set
      * @param func Name of function where error occurred (use __func__)
      * @param line Line number where error occurred (use __LINE__)
-     * @param arg_name Name of argument causing error (NULL if not applicable)
-     * @param user_msg Human-readable error message (NULL for default)
+     * @param arg_name Name of argument causing error (NULL if not applicable, copied)
+     * @param user_msg Human-readable error message (NULL for default, must outlive the error)
+     * @note The full message is only formatted when argparse_error_get_message() is called.
      */
     void argparse_error_set(ArgParseErrorCategory category, int errno_val,
         const char* func, int line, const char* arg_name,
@@ -75,6 +74,19 @@ extern "C" {
     */
     const char* argparse_error_get_message(void);
 
+    /**
+     * @brief Attaches a suggestion to the current error, shown after its message.
+     * @param hint Text such as "did you mean '--verbose'?" (copied, truncated if long)
+     * @note Ignored without a current error; the next error or clear drops it.
+    */
+    void argparse_error_set_hint(const char* hint);
+
+    /**
+     * @brief Returns the suggestion attached to the last error.
+     * @return Hint text, or empty string if none.
+    */
+    const char* argparse_error_get_hint(void);
+
     /**
      * @brief Returns the name of the argument that caused the last error.
      * @return Argument name, or empty string if no argument or no error.
@@ -0,0 +1,20 @@
+#ifndef ARGPARSE_FWD_H
+#define ARGPARSE_FWD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* C99 allows a typedef only once, every header that needs these names includes this one. */
+
+    /* @brief One registered argument, see argparse.h. */
+    typedef struct Argument Argument;
+
+    /* @brief Argument parser, see argparse.h. */
+    typedef struct ArgParser ArgParser;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
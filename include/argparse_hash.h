@@ -3,43 +3,106 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "argparse_arena.h"
+#include "argparse_fwd.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
 #define ARGPARSE_HASH_THRESHOLD 16
-#define ARGPARSE_HASH_TABLE_SIZE 256
+#define ARGPARSE_HASH_MIN_CAPACITY 32
 #define ARGPARSE_HASH_LOAD_FACTOR 0.75f
+#define ARGPARSE_HASH_FIXED_SEED 0x9E3779B9U
 
-    /* @brief Collision chain node storing argument name-to-structure mappings. */
+/* Sorted-index neighbours on each side of a misspelled name that are scored as suggestions. */
+#define ARGPARSE_SUGGEST_WINDOW 8
+/* Longer names are never scored, bounding the edit-distance rows kept on the stack. */
+#define ARGPARSE_SUGGEST_MAX_LEN 64
+
+/* Block size of the pool holding a parser's interned names and help texts. */
+#define ARGPARSE_INTERN_BLOCK_SIZE 4096
+#define ARGPARSE_INTERN_MIN_CAPACITY 32
+
+    /* @brief How a parser's hash table obtains its randomization seed. */
+    typedef enum ArgHashSeedPolicy {
+        ARGPARSE_SEED_SECURE = 0,   /* Fresh OS CSPRNG seed per table (default) */
+        ARGPARSE_SEED_PROCESS,      /* One CSPRNG seed per process, shared by all parsers */
+        ARGPARSE_SEED_FIXED         /* Constant seed, no entropy: trusted argv only */
+    } ArgHashSeedPolicy;
+
+    /* @brief Inline open-addressing slot storing an argument name-to-structure mapping. */
     typedef struct HashEntry HashEntry;
 
-    /* @brief Fast hash table for argument lookup with auto-resizing and collision handling. */
+    /* @brief Fast hash table for argument lookup with auto-resizing and linear probing. */
     typedef struct ArgHashTable ArgHashTable;
 
-    typedef struct Argument Argument;
-    typedef struct ArgParser ArgParser;
+    /* @brief One name of the sorted index. */
+    typedef struct ArgNameEntry ArgNameEntry;
+
+    /*
+     * @brief Every registered name ordered by its stem, the name without leading dashes, so
+     *        "-verbose", "--verbose" and "-v" are neighbours for prefix and near-miss searches.
+    */
+    typedef struct ArgNameIndex ArgNameIndex;
+
+    /* @brief One distinct string of an intern pool. */
+    typedef struct ArgInternSlot ArgInternSlot;
+
+    /* @brief Deduplicated strings of one parser, packed into one arena and freed with it. */
+    typedef struct ArgInternPool ArgInternPool;
 
     struct HashEntry {
-        char* key;              /* Argument name (short or long) */
-        Argument* argument;     /* Pointer to original Argument structure */
-        struct HashEntry* next; /* Next entry in collision chain */
+        uint32_t hash;          /* Cached full hash of the key */
+        uint32_t key_len;       /* Key length, compared before any memcmp */
+        const char* key;        /* Argument name (borrowed from the Argument) */
+        Argument* argument;     /* Pointer to original Argument structure, NULL if empty */
     };
 
     struct ArgHashTable {
-        HashEntry** buckets;    /* Array of bucket pointers */
-        size_t capacity;        /* Number of buckets (power of two) */
+        HashEntry* slots;       /* Inline entries, probed linearly */
+        size_t capacity;        /* Number of slots (power of two) */
         size_t size;            /* Number of stored entries */
         uint32_t seed;          /* Random seed for hash randomization */
+        ArgArena* arena;        /* Owning parser's arena (NULL for heap storage) */
+    };
+
+    struct ArgNameEntry {
+        const char* name;       /* Short or long name (borrowed from the Argument) */
+        const char* stem;       /* name past its leading dashes, the sort key */
+        size_t stem_len;        /* strlen(stem) */
+        Argument* argument;     /* Argument the name belongs to */
+    };
+
+    struct ArgInternSlot {
+        const char* str;        /* Interned copy, NULL if empty */
+        uint32_t hash;          /* Cached hash of the string */
+        uint32_t len;           /* String length */
+    };
+
+    struct ArgInternPool {
+        ArgArena* arena;        /* Owns the strings and the pool header */
+        ArgInternSlot* slots;   /* Open addressing, probed linearly (heap storage) */
+        size_t capacity;        /* Number of slots (power of two) */
+        size_t count;           /* Number of distinct strings */
+    };
+
+    struct ArgNameIndex {
+        ArgNameEntry* entries;  /* Contiguous, sorted by name */
+        size_t count;           /* Number of entries */
+        ArgArena* arena;        /* Owning arena (NULL for heap storage) */
     };
 
     /**
      * @brief Creates and initializes a new hash table instance.
+     * @param arena Arena to allocate buckets and entries from (NULL for the heap)
+     * @param policy Seed source for hash randomization
+     * @param expected_entries Number of names expected, used to size the slot array
      * @return - Pointer to newly allocated ArgHashTable on success
      * @return - NULL on memory allocation failure (sets APE_MEMORY error)
     */
-    ArgHashTable* argparse_hash_create_internal(void);
+    ArgHashTable* argparse_hash_create_internal(ArgArena* arena, ArgHashSeedPolicy policy,
+        size_t expected_entries);
 
     /**
      * @brief Completely destroys a hash table and all its entries.
@@ -50,7 +113,8 @@ extern "C" {
     /**
      * @brief Inserts or updates a key-argument mapping in the hash table.
      * @param table Target hash table (must not be NULL)
-     * @param key Argument name (short or long form, e.g., "-v" or "--verbose")
+     * @param key Argument name (short or long form, e.g., "-v" or "--verbose"); stored
+     *            by reference, so it must live as long as the table (normally arg's own name)
      * @param arg Pointer to Argument structure (must not be NULL)
      * @return - true on success
      * @return - false on failure (sets appropriate error)
@@ -66,6 +130,42 @@ extern "C" {
     */
     Argument* argparse_hash_lookup_internal(ArgHashTable* table, const char* key);
 
+    /**
+     * @brief Length-delimited variant of argparse_hash_lookup_internal().
+     * @param table Hash table to search (NULL-safe)
+     * @param key Start of the name, need not be NUL-terminated
+     * @param len Number of bytes in the name
+     * @return - Pointer to Argument structure if found
+     * @return - NULL if not found or table is NULL
+    */
+    Argument* argparse_hash_lookup_internal_n(ArgHashTable* table, const char* key, size_t len);
+
+    /**
+     * @brief Seeded string hash shared by the runtime table and static spec indices.
+     * @param str NUL-terminated key (NULL hashes to 0)
+     * @param seed Hash seed
+     * @return 32-bit hash value.
+    */
+    uint32_t argparse_hash_string_internal(const char* str, uint32_t seed);
+
+    /**
+     * @brief String hash that also returns the key length, so no separate strlen() pass.
+     * @param str NUL-terminated key (NULL hashes to 0)
+     * @param seed Hash seed
+     * @param len Receives strlen(str)
+     * @return 32-bit hash value, equal to argparse_hash_bytes_internal(str, *len, seed).
+    */
+    uint32_t argparse_hash_string_len_internal(const char* str, uint32_t seed, size_t* len);
+
+    /**
+     * @brief Seeded hash over exactly len bytes; equals the string hash of the same bytes.
+     * @param data Key bytes (NULL hashes to 0)
+     * @param len Number of bytes to hash
+     * @param seed Hash seed
+     * @return 32-bit hash value.
+    */
+    uint32_t argparse_hash_bytes_internal(const char* data, size_t len, uint32_t seed);
+
     /**
      * @brief Ensures the parser's hash table is built if threshold is reached.
      * @param parser Argument parser instance
@@ -83,6 +183,16 @@ extern "C" {
     */
     Argument* argparse_hash_find_argument(ArgParser* parser, const char* name);
 
+    /**
+     * @brief Lookup by slice, e.g. the "--output" part of "--output=file", without copying.
+     * @param parser Parser instance (NULL-safe)
+     * @param name Start of the name, need not be NUL-terminated
+     * @param len Number of bytes in the name
+     * @return - Pointer to Argument structure if found
+     * @return - NULL if not found or parser is NULL
+    */
+    Argument* argparse_hash_find_argument_n(ArgParser* parser, const char* name, size_t len);
+
     /**
      * @brief Checks if a string corresponds to a registered argument name.
      * @param parser Parser instance (NULL-safe)
@@ -92,6 +202,81 @@ extern "C" {
     */
     bool argparse_hash_is_argument(ArgParser* parser, const char* str);
 
+    /**
+     * @brief Builds the sorted index over the short and long names of a list of arguments.
+     * @param arena Arena to allocate from (NULL for the heap)
+     * @param arguments First argument, the whole next chain is indexed
+     * @return - Index (release with argparse_name_index_destroy_internal)
+     * @return - NULL on memory allocation failure (sets APE_MEMORY error)
+    */
+    ArgNameIndex* argparse_name_index_create_internal(ArgArena* arena, Argument* arguments);
+
+    /**
+     * @brief Releases a sorted name index.
+     * @param index Index to destroy (NULL-safe), arena storage is left to its arena
+    */
+    void argparse_name_index_destroy_internal(ArgNameIndex* index);
+
+    /**
+     * @brief Finds the run of names whose stem starts with a prefix by binary search.
+     * @param index Index to search
+     * @param prefix Start of the prefix without dashes, need not be NUL-terminated
+     * @param len Number of bytes in the prefix
+     * @param first Receives the index of the first matching entry
+     * @return Number of matching entries, contiguous from *first (any number of dashes).
+    */
+    size_t argparse_name_index_prefix_internal(const ArgNameIndex* index, const char* prefix,
+        size_t len, size_t* first);
+
+    /**
+     * @brief Closest registered name to a misspelled one.
+     * @param index Index to search
+     * @param name Unknown name
+     * @return - Entry within a small edit distance (transpositions count once)
+     * @return - NULL when nothing is close enough
+     * @note Only the ARGPARSE_SUGGEST_WINDOW neighbours on each side of the stem are scored,
+     *       so a typo in the first letters may go without a suggestion.
+    */
+    const ArgNameEntry* argparse_name_index_suggest_internal(const ArgNameIndex* index,
+        const char* name);
+
+    /**
+     * @brief Returns the parser's sorted name index, building it on first use.
+     * @param parser Parser instance (NULL-safe)
+     * @return - Index, valid until the next argument is added
+     * @return - NULL on memory allocation failure or NULL parser
+     * @note A result view builds a private index when its schema has none yet.
+    */
+    const ArgNameIndex* argparse_hash_name_index(ArgParser* parser);
+
+    /**
+     * @brief Drops the parser's sorted name index after its arguments changed.
+     * @param parser Parser instance (NULL-safe)
+    */
+    void argparse_hash_invalidate_name_index(ArgParser* parser);
+
+    /**
+     * @brief Creates an empty intern pool.
+     * @return - Pool (release with argparse_intern_pool_destroy_internal)
+     * @return - NULL on memory allocation failure (sets APE_MEMORY error)
+    */
+    ArgInternPool* argparse_intern_pool_create_internal(void);
+
+    /**
+     * @brief Returns the pooled copy of a string, adding it on first use.
+     * @param pool Target pool
+     * @param str String to intern (NULL-safe, returns NULL)
+     * @return - Copy shared by every equal string, valid until the pool is destroyed
+     * @return - NULL on memory allocation failure (no error is set)
+    */
+    char* argparse_intern_internal(ArgInternPool* pool, const char* str);
+
+    /**
+     * @brief Releases a pool and every string interned into it.
+     * @param pool Pool to destroy (NULL-safe)
+    */
+    void argparse_intern_pool_destroy_internal(ArgInternPool* pool);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,51 @@
+#ifndef ARGPARSE_NUMBER_H
+#define ARGPARSE_NUMBER_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Define ARGPARSE_NO_SIMD to force the portable scalar digit scanner. */
+#if !defined(ARGPARSE_NO_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ARGPARSE_NUMBER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define ARGPARSE_NUMBER_NEON 1
+#endif
+#endif
+
+    /**
+     * @brief Counts the ASCII digits at the start of a buffer.
+     * @param str Start of the run
+     * @param avail Readable bytes from str (the vector path never reads past them)
+     * @return Number of leading '0'..'9' characters.
+    */
+    size_t argparse_number_digit_run_internal(const char* str, size_t avail);
+
+    /**
+     * @brief Fast path for one plain decimal int: optional sign, then digits.
+     * @param str Start of the token
+     * @param avail Readable bytes from str
+     * @param out Converted value
+     * @return - Number of characters consumed on success
+     * @return - 0 when the token needs the strtol path (whitespace, overflow, ...)
+    */
+    size_t argparse_number_parse_int_internal(const char* str, size_t avail, int* out);
+
+    /**
+     * @brief Exact fast path for short decimal doubles (Clinger), e.g. "-12.5e3".
+     * @param str Start of the token
+     * @param avail Readable bytes from str
+     * @param out Converted value, correctly rounded
+     * @return - Number of characters consumed on success
+     * @return - 0 when the token needs the strtod path (long mantissa, big exponent, hex, ...)
+    */
+    size_t argparse_number_parse_double_internal(const char* str, size_t avail, double* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
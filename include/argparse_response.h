@@ -0,0 +1,76 @@
+#ifndef ARGPARSE_RESPONSE_H
+#define ARGPARSE_RESPONSE_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Response files smaller than this are read into the heap; mapping them costs more than the copy. */
+#define ARGPARSE_RESPONSE_MMAP_MIN 65536
+
+    /* @brief Block of words split in place: each word NUL-terminated, back to back. */
+    typedef struct ArgWords ArgWords;
+
+    struct ArgWords {
+        char* data;             /* First word */
+        size_t size;            /* Bytes owned by data (the mapping length when mapped) */
+        size_t count;           /* Number of words */
+        bool mapped;            /* data is a private file mapping, otherwise heap memory */
+        struct ArgWords* next;  /* Next block retained by the same parser */
+    };
+
+    /**
+     * @brief Splits text in place with shell-like rules and packs the words to the front.
+     * @param data Text to split, with one writable spare byte at data[len]
+     * @param len Number of text bytes
+     * @param count Number of words found
+     * @return - true on success
+     * @return - false on an unterminated quote (sets APE_SYNTAX error)
+     * @note Whitespace and NUL separate words, '...' is literal, "..." honours \" and \\,
+     *       a backslash outside quotes escapes the next character and joins continued lines.
+    */
+    bool argparse_words_split_internal(char* data, size_t len, size_t* count);
+
+    /**
+     * @brief Packs the KEY=VALUE lines of a config file in place as alternating key and value words.
+     * @param data Text to split, with one writable spare byte at data[len]
+     * @param len Number of text bytes
+     * @param count Number of words found (twice the number of pairs)
+     * @return true (malformed lines are skipped)
+     * @note Blanks around keys and values are trimmed and one level of matching quotes is
+     *       removed; lines starting with '#' or ';' and [section] headers are ignored.
+    */
+    bool argparse_words_split_config_internal(char* data, size_t len, size_t* count);
+
+    /**
+     * @brief Loads a file into a private, writable block with one spare byte, mapping it when
+     *        large enough; count is left at 0.
+     * @param path File to read
+     * @return - Block (release with argparse_words_free_internal)
+     * @return - NULL when the file cannot be read (APE_VALIDATION) or memory runs out (APE_MEMORY)
+    */
+    ArgWords* argparse_file_load_internal(const char* path);
+
+    /**
+     * @brief Loads and splits a response file, mapping it when large enough.
+     * @param path File to read
+     * @return - Word block (release with argparse_words_free_internal)
+     * @return - NULL when the file cannot be read (APE_VALIDATION), is malformed (APE_SYNTAX)
+     *           or memory runs out (APE_MEMORY)
+    */
+    ArgWords* argparse_words_load_internal(const char* path);
+
+    /**
+     * @brief Releases a chain of word blocks.
+     * @param words First block (NULL-safe), every block reachable through next is freed
+    */
+    void argparse_words_free_internal(ArgWords* words);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
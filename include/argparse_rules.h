@@ -0,0 +1,108 @@
+#ifndef ARGPARSE_RULES_H
+#define ARGPARSE_RULES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "argparse_arena.h"
+#include "argparse_fwd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Argument indices per bitset word. */
+#define ARGPARSE_BITS_PER_WORD 64
+/* Words needed for count indices. */
+#define ARGPARSE_BIT_WORDS(count) (((count) + ARGPARSE_BITS_PER_WORD - 1) / ARGPARSE_BITS_PER_WORD)
+#define ARGPARSE_BIT_WORD(index) ((index) / ARGPARSE_BITS_PER_WORD)
+#define ARGPARSE_BIT_MASK(index) ((ArgBits)1 << ((index) % ARGPARSE_BITS_PER_WORD))
+#define ARGPARSE_BIT_TEST(bits, index) (((bits)[ARGPARSE_BIT_WORD(index)] & ARGPARSE_BIT_MASK(index)) != 0)
+/* Returned by the bit scans when no index qualifies. */
+#define ARGPARSE_BIT_NONE SIZE_MAX
+
+    /* @brief One word of a bitset over argument indices (Argument.index). */
+    typedef uint64_t ArgBits;
+
+    /* @brief Arguments of which at most one (exactly one when required) may be given. */
+    typedef struct ArgGroup ArgGroup;
+
+    /* @brief Arguments that must be given whenever one argument is. */
+    typedef struct ArgDependency ArgDependency;
+
+    struct ArgGroup {
+        ArgBits* members;           /* Member indices */
+        size_t words;               /* Words in members, enough for the highest member */
+        bool required;              /* One member must be given */
+        ArgGroup* next;
+    };
+
+    struct ArgDependency {
+        size_t index;               /* Dependent argument */
+        ArgBits* needs;             /* Arguments it requires */
+        size_t words;               /* Words in needs */
+        ArgDependency* next;
+    };
+
+    /**
+     * @brief Grows a bitset, zeroing the new words.
+     * @param arena Arena of the parser, NULL for the heap
+     * @param bits Bitset to grow, replaced on success
+     * @param words Current number of words
+     * @param new_words Requested number of words
+     * @return false when memory runs out (bits is left untouched, no error is set).
+    */
+    bool argparse_bits_grow_internal(ArgArena* arena, ArgBits** bits, size_t words, size_t new_words);
+
+    /**
+     * @brief Finds the lowest index in wanted but not in present, starting at a given index.
+     * @param wanted Indices to look for
+     * @param present Indices already there, at least words long
+     * @param words Words to scan
+     * @param from Lowest index considered
+     * @return Index, or ARGPARSE_BIT_NONE when present covers the rest of wanted.
+    */
+    size_t argparse_bits_next_missing_internal(const ArgBits* wanted, const ArgBits* present,
+        size_t words, size_t from);
+
+    /**
+     * @brief Finds the lowest index in both bitsets, starting at a given index.
+     * @param a First bitset
+     * @param b Second bitset
+     * @param words Words to scan
+     * @param from Lowest index considered
+     * @return Index, or ARGPARSE_BIT_NONE when there is none.
+    */
+    size_t argparse_bits_first_common_internal(const ArgBits* a, const ArgBits* b, size_t words,
+        size_t from);
+
+    /**
+     * @brief Counts the indices in both bitsets.
+     * @param a First bitset
+     * @param b Second bitset
+     * @param words Words to scan
+     * @return Number of common indices.
+    */
+    size_t argparse_bits_count_common_internal(const ArgBits* a, const ArgBits* b, size_t words);
+
+    /**
+     * @brief Makes room for an argument index in the parser bitsets and records its flags.
+     * @param parser Parser the argument is being added to
+     * @param index Dense index of the new argument
+     * @param required Whether the argument is required
+     * @param eager Whether its fallback must be resolved at the end of each parse
+     * @return false when memory runs out (no error is set).
+    */
+    bool argparse_rules_index_internal(ArgParser* parser, size_t index, bool required, bool eager);
+
+    /**
+     * @brief Releases the bitsets, groups and dependencies of a heap parser.
+     * @param parser Parser being freed
+    */
+    void argparse_rules_free_internal(ArgParser* parser);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
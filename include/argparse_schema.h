@@ -0,0 +1,79 @@
+#ifndef ARGPARSE_SCHEMA_H
+#define ARGPARSE_SCHEMA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "argparse_fwd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever the blob layout changes; older blobs are rejected on load. */
+#define ARGPARSE_SCHEMA_VERSION 1u
+
+/* "APS1" read as a native uint32, also catches blobs from a machine of other endianness. */
+#define ARGPARSE_SCHEMA_MAGIC 0x31535041u
+
+    /* @brief Fixed header at offset 0 of a schema blob; every offset is relative to the blob. */
+    typedef struct ArgSchemaHeader ArgSchemaHeader;
+
+    /* @brief One argument of a schema blob. */
+    typedef struct ArgSchemaRecord ArgSchemaRecord;
+
+    struct ArgSchemaHeader {
+        uint32_t magic;             /* ARGPARSE_SCHEMA_MAGIC */
+        uint32_t version;           /* ARGPARSE_SCHEMA_VERSION */
+        uint32_t index_version;     /* ARGPARSE_SPEC_INDEX_VERSION of the embedded hash */
+        uint32_t size;              /* Total blob size in bytes */
+        uint32_t count;             /* Number of records, the implicit help excluded */
+        uint32_t description;       /* Offset of the description string, 0 if none */
+        uint32_t records;           /* Offset of count ArgSchemaRecord entries */
+        uint32_t pilots;            /* Offset of bucket_mask + 1 uint16_t pilots */
+        uint32_t slots;             /* Offset of slot_mask + 1 uint32_t slots */
+        uint32_t seed;              /* Perfect hash seed */
+        uint32_t bucket_mask;       /* Bucket count - 1 */
+        uint32_t slot_mask;         /* Slot count - 1 */
+    };
+
+    struct ArgSchemaRecord {
+        uint32_t short_name;        /* Offset of the name string, 0 if none */
+        uint32_t long_name;         /* Offset of the name string, 0 if none */
+        uint32_t help;              /* Offset of the help string, 0 if none */
+        uint32_t default_value;     /* Offset of an int, double, bool or string, 0 if none */
+        uint8_t type;               /* ArgType */
+        uint8_t required;           /* Non-zero if the argument is required */
+        uint8_t suffix;             /* GNU-style suffix, 0 for none */
+        uint8_t delimiter;          /* List delimiter */
+        uint32_t reserved;          /* Zero, keeps records 8-byte sized */
+    };
+
+    /**
+     * @brief Serializes the arguments of a parser and their perfect hash into one flat blob.
+     * @param parser Parser to snapshot, before any parse (current values become the defaults)
+     * @param buf Destination, 8-byte aligned, written only when len is large enough
+     * @param len Size of buf in bytes (0 to query the size)
+     * @return - Size of the blob, a result > len means nothing was written
+     * @return - 0 on error: bound or streaming arguments, exclusive groups or dependencies,
+     *           fallback sources, parser flags or subcommands (APE_CONFIG), oversized schema
+     *           (APE_RANGE)
+     * @note The blob holds the arguments only; parsers with state it cannot carry are rejected
+     *       rather than saved incomplete.
+     * @note The blob uses native byte order and type sizes; it is meant for the same build.
+    */
+    size_t argparse_save_schema(ArgParser* parser, void* buf, size_t len);
+
+    /**
+     * @brief Creates a parser straight from a schema blob, without registration or hashing.
+     * @param blob Blob from argparse_save_schema(), 8-byte aligned (e.g. mmap()ed file contents)
+     * @param size Number of bytes available at blob
+     * @return - Parser whose names and help point into the blob, which must outlive it
+     * @return - NULL on a malformed or stale blob (APE_CONFIG) or memory failure (APE_MEMORY)
+    */
+    ArgParser* argparse_load_schema(const void* blob, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef ARGPARSE_SPEC_H
+#define ARGPARSE_SPEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "argparse_fwd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever the index layout or the name hash changes; stale generated indices are rejected. */
+#define ARGPARSE_SPEC_INDEX_VERSION 2u
+
+/* Slot value marking an empty perfect-hash slot. */
+#define ARGPARSE_SPEC_EMPTY_SLOT 0u
+
+    /* @brief Static argument declaration, see ARGPARSE_SPEC in argparse.h. */
+    typedef struct ArgSpec ArgSpec;
+
+    /* @brief Collision-free hash index over the names of a static ArgSpec table. */
+    typedef struct ArgSpecIndex ArgSpecIndex;
+
+    struct ArgSpecIndex {
+        uint32_t version;       /* ARGPARSE_SPEC_INDEX_VERSION at generation time */
+        uint32_t spec_count;    /* Number of ArgSpec entries the index was built for */
+        uint32_t seed;          /* Fixed hash seed found by the generator */
+        uint32_t bucket_mask;   /* Bucket count - 1 (power of two) */
+        uint32_t slot_mask;     /* Slot count - 1 (power of two) */
+        const uint16_t* pilots; /* Per-bucket displacement selecting the final slot */
+        const uint32_t* slots;  /* Name id + 1 per slot, ARGPARSE_SPEC_EMPTY_SLOT if unused */
+    };
+
+    /**
+     * @brief Builds a perfect hash over every name in a spec table plus the implicit "-h"/"--help".
+     * @param specs Static argument table
+     * @param count Number of entries in the table
+     * @return - Index in a single heap allocation (release with argparse_spec_index_free)
+     * @return - NULL on duplicate names (APE_DUPLICATE) or allocation failure (APE_MEMORY)
+     * @note Name id 2*i is specs[i].short_name, 2*i+1 is specs[i].long_name; id 2*count and
+     *       2*count+1 are the implicit help names.
+    */
+    ArgSpecIndex* argparse_spec_index_create(const ArgSpec* specs, size_t count);
+
+    /**
+     * @brief Releases an index returned by argparse_spec_index_create().
+     * @param index Index to free (NULL-safe)
+    */
+    void argparse_spec_index_free(ArgSpecIndex* index);
+
+    /**
+     * @brief Emits an index as C source so it can be compiled in next to the spec table.
+     * @param out Destination stream
+     * @param index Index to serialize
+     * @param symbol Name of the generated `static const ArgSpecIndex` object
+     * @return - true on success
+     * @return - false on invalid parameters or write failure
+    */
+    bool argparse_spec_index_write(FILE* out, const ArgSpecIndex* index, const char* symbol);
+
+    /**
+     * @brief Single-probe lookup of a name in a parser built by argparse_new_from_spec().
+     * @param parser Parser owning the spec arguments
+     * @param name Start of the argument name, need not be NUL-terminated
+     * @param len Number of bytes in the name
+     * @return Matching Argument, or NULL if the name is not part of the spec.
+    */
+    Argument* argparse_spec_lookup_internal(const ArgParser* parser, const char* name, size_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
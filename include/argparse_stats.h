@@ -0,0 +1,102 @@
+#ifndef ARGPARSE_STATS_H
+#define ARGPARSE_STATS_H
+
+#include "argparse_fwd.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Define ARGPARSE_STATS (make STATS=1) to count and time the work done by each parse. */
+
+    /* @brief Timed phases of a parse. */
+    typedef enum ArgParsePhase {
+        ARGPARSE_PHASE_GNU,         /* GNU name<suffix>value detection */
+        ARGPARSE_PHASE_LOOKUP,      /* Name lookups while classifying tokens */
+        ARGPARSE_PHASE_CONVERT,     /* Value conversion and storage */
+        ARGPARSE_PHASE_VALIDATE,    /* Required arguments and eager fallbacks */
+        ARGPARSE_PHASE_COUNT
+    } ArgParsePhase;
+
+    /* @brief Totals over every parse of one parser since it was created or reset. */
+    typedef struct ArgParseStats ArgParseStats;
+
+    struct ArgParseStats {
+        unsigned long long parses;              /* Parse calls, subcommand parses count in the child */
+        unsigned long long hash_lookups;        /* Argument name lookups */
+        unsigned long long string_compares;     /* Name comparisons after a hash or probe hit */
+        unsigned long long allocations;         /* Heap or arena allocations */
+        unsigned long long bytes_copied;        /* Bytes duplicated into parser memory */
+        unsigned long long list_elements;       /* List elements stored or streamed */
+        unsigned long long phase_ns[ARGPARSE_PHASE_COUNT]; /* Time per ArgParsePhase */
+    };
+
+#ifdef ARGPARSE_STATS
+
+    /**
+     * @brief Statistics of the parse running on this thread.
+     * @return Counters to update, NULL outside a parse.
+    */
+    ArgParseStats* argparse_stats_active_internal(void);
+
+    /**
+     * @brief Monotonic clock for phase timing.
+     * @return Nanoseconds from an arbitrary origin.
+    */
+    unsigned long long argparse_stats_now_internal(void);
+
+#define ARGPARSE_STATS_ADD(field, amount) do { \
+        ArgParseStats* stats_ = argparse_stats_active_internal(); \
+        if (stats_) stats_->field += (amount); \
+    } while (0)
+
+#define ARGPARSE_STATS_START(var) \
+    unsigned long long var = argparse_stats_active_internal() ? argparse_stats_now_internal() : 0
+
+#define ARGPARSE_STATS_STOP(var, phase) do { \
+        ArgParseStats* stats_ = argparse_stats_active_internal(); \
+        if (stats_) stats_->phase_ns[phase] += argparse_stats_now_internal() - (var); \
+    } while (0)
+
+#else
+
+#define ARGPARSE_STATS_ADD(field, amount) ((void)0)
+#define ARGPARSE_STATS_START(var) ((void)0)
+#define ARGPARSE_STATS_STOP(var, phase) ((void)0)
+
+#endif
+
+    /**
+     * @brief Makes the statistics of a parser the active ones on this thread.
+     * @param parser Parser about to parse (result views are not instrumented)
+     * @return Previously active statistics, to hand back to argparse_stats_leave_internal().
+     * @note A no-op returning NULL unless built with ARGPARSE_STATS.
+    */
+    ArgParseStats* argparse_stats_enter_internal(ArgParser* parser);
+
+    /**
+     * @brief Restores the statistics that were active before argparse_stats_enter_internal().
+     * @param previous Its return value
+    */
+    void argparse_stats_leave_internal(ArgParseStats* previous);
+
+    /**
+     * @brief Returns the counters and phase times collected by a parser.
+     * @param parser Parser instance
+     * @return - Statistics, updated in place by later parses and valid until argparse_free()
+     * @return - NULL before the first parse or when built without ARGPARSE_STATS
+     * @note argparse_parse_r() results are not instrumented.
+    */
+    const ArgParseStats* argparse_get_stats(const ArgParser* parser);
+
+    /**
+     * @brief Zeroes the statistics of a parser.
+     * @param parser Parser instance (NULL-safe)
+    */
+    void argparse_reset_stats(ArgParser* parser);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
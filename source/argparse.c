@@ -1,5 +1,7 @@
 #include "argparse.h"
 #include "argparse_hash.h"
+#include "argparse_arena.h"
+#include "argparse_number.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -8,9 +10,10 @@
 #include <limits.h>
 #include <ctype.h>
 
+/* Result views (argparse_parse_r) and batches report fatal errors instead of exiting. */
 #define APE_RETURN_IF_ERROR(parser) \
     if (argparse_error_occurred()) { \
-        if (argparse_error_is_fatal()) { \
+        if (argparse_error_is_fatal() && !((parser) && ((parser)->overlay || (parser)->batch))) { \
             argparse_print_help(parser); \
             exit(EXIT_FAILURE); \
         } \
@@ -60,6 +63,7 @@ static void insert_argument_into_hash_table(ArgParser* parser, Argument* arg) {
     if (!parser || !arg) return;
 
     parser->argument_count++;
+    argparse_hash_invalidate_name_index(parser);
 
     /* insert into hash table if it exists */
     if (parser->hash_table) {
@@ -75,11 +79,10 @@ static void insert_argument_into_hash_table(ArgParser* parser, Argument* arg) {
         ensure_hash_table_built(parser);
 }
 
-/* Internal list node structure */
-typedef struct ListNode {
-    void* data;
-    struct ListNode* next;
-} ListNode;
+/* Initial element capacity reserved on the first append to a list. */
+#define ARGPARSE_LIST_INITIAL_CAPACITY 8
+/* Arguments per block of the node arena. */
+#define ARGPARSE_NODE_BLOCK_ARGS 32
 
 static bool is_list_type(ArgType type) {
     return ((type == ARG_INT_LIST)
@@ -87,60 +90,61 @@ static bool is_list_type(ArgType type) {
         || (type == ARG_STRING_LIST));
 }
 
-static void* create_default_value(ArgType type) {
+static size_t list_element_size(ArgType type) {
     switch (type) {
-    case ARG_INT: {
-        int* val = (int*)malloc(sizeof(int));
-        if (!val) return NULL;
-
-        *val = 0;
-        return val;
+    case ARG_INT_LIST:
+        return sizeof(int);
+    case ARG_DOUBLE_LIST:
+        return sizeof(double);
+    case ARG_STRING_LIST:
+        return sizeof(char*);
+    default:
+        return 0;
     }
-    case ARG_DOUBLE: {
-        double* val = (double*)malloc(sizeof(double));
-        if (!val) return NULL;
+}
 
-        *val = 0.0;
-        return val;
-    }
-    case ARG_STRING:
-        return NULL;
-    case ARG_BOOL: {
-        bool* val = (bool*)malloc(sizeof(bool));
-        if (!val) return NULL;
+/* Grow list storage geometrically so that at least one more element fits. */
+static bool list_reserve(ArgParser* parser, Argument* arg, size_t min_capacity) {
+    if (min_capacity <= arg->list_capacity)
+        return true;
 
-        *val = false;
-        return val;
-    }
-    case ARG_INT_LIST:
-    case ARG_DOUBLE_LIST:
-    case ARG_STRING_LIST: {
-        ListNode** list = (ListNode**)malloc(sizeof(ListNode*));
-        if (!list) return NULL;
+    const char* arg_name = arg->long_name ? arg->long_name :
+        arg->short_name ? arg->short_name :
+        "(unnamed)";
+
+    size_t new_capacity = arg->list_capacity
+        ? arg->list_capacity : ARGPARSE_LIST_INITIAL_CAPACITY;
 
-        *list = NULL;
-        return list;
+    while (new_capacity < min_capacity) {
+        if (!safe_multiply_size_t(new_capacity, 2, &new_capacity))
+            return false;
     }
-    default:
-        return NULL;
+
+    size_t elem_size = list_element_size(arg->type);
+    size_t alloc_size;
+
+    if (!safe_multiply_size_t(new_capacity, elem_size, &alloc_size))
+        return false;
+
+    void* buffer = argparse_arena_realloc(parser->arena, arg->value,
+        arg->list_capacity * elem_size, alloc_size);
+    if (!buffer) {
+        APE_SET_MEMORY(arg_name);
+        return false;
     }
+
+    arg->value = buffer;
+    arg->list_capacity = new_capacity;
+    return true;
 }
 
-static void append_to_list(Argument* arg, void* value) {
+/* Reserve the next element of a list argument and return its address. */
+static void* list_push(ArgParser* parser, Argument* arg) {
     /* validate inputs */
     if (!arg) {
         APE_SET(APE_INTERNAL, EINVAL, NULL,
-            "append_to_list: Argument pointer is NULL.");
-        return;
-    }
-
-    if (!value) {
-        const char* arg_name = arg->long_name ? arg->long_name :
-            arg->short_name ? arg->short_name :
-            "(unnamed)";
-        APE_SET(APE_INTERNAL, EINVAL, arg_name,
-            "append_to_list: Cannot append NULL value to list.");
-        return;
+            "list_push: Argument pointer is NULL.");
+        return NULL;
     }
 
     /* type safety verification */
@@ -149,86 +153,112 @@ static void append_to_list(Argument* arg, void* value) {
             arg->short_name ? arg->short_name :
             "(unnamed)";
         APE_SET(APE_INTERNAL, EINVAL, arg_name,
-            "append_to_list: called on non-list argument.");
-        return;
+            "list_push: called on non-list argument.");
+        return NULL;
     }
 
-    /* storage initialization check */
-    if (!arg->value) {
-        arg->value = malloc(sizeof(ListNode*));
+    /* amortized O(1) growth */
+    if (arg->list_count == arg->list_capacity &&
+        !list_reserve(parser, arg, arg->list_count + 1))
+        return NULL;
 
-        if (!arg->value) {
-            const char* arg_name = arg->long_name ? arg->long_name :
-                arg->short_name ? arg->short_name :
-                "(unnamed)";
-            APE_SET_MEMORY(arg_name);
-            return;
-        }
+    ARGPARSE_STATS_ADD(list_elements, 1);
 
-        /* initialize to empty list */
-        *(ListNode**)arg->value = NULL;
-    }
+    char* base = (char*)arg->value;
+    return base + arg->list_count++ * list_element_size(arg->type);
+}
 
-    /* type-safe pointer conversion */
-    ListNode** head_ptr = (ListNode**)arg->value;
+/* Drop all stored elements while keeping the allocated capacity. */
+static void list_clear(ArgParser* parser, Argument* arg) {
+    if (!arg || !arg->is_list || !arg->value) return;
 
-    /* double-check the cast result */
-    if (!head_ptr) {
-        const char* arg_name = arg->long_name ? arg->long_name :
-            arg->short_name ? arg->short_name :
-            "(unnamed)";
-        APE_SET(APE_INTERNAL, EINVAL, arg_name,
-            "List head pointer is NULL after validation.");
-        return;
+    if (arg->type == ARG_STRING_LIST && !parser->arena && !arg->borrowed) {
+        char** strings = (char**)arg->value;
+
+        for (size_t i = 0; i < arg->list_count; i++)
+            free(strings[i]);
     }
 
-    /* node allocation */
-    ListNode* new_node = (ListNode*)malloc(sizeof(ListNode));
+    arg->list_count = 0;
+}
 
-    if (!new_node) {
-        const char* arg_name = arg->long_name ? arg->long_name :
-            arg->short_name ? arg->short_name :
-            "(unnamed)";
+/* Drops the rendered help text; it is rebuilt on the next request. */
+static void invalidate_help(ArgParser* parser) {
+    argparse_arena_free(parser->arena, parser->help_text);
+    parser->help_text = NULL;
+    parser->help_length = 0;
+}
 
-        /* clean up arg->value if we just allocated it */
-        if (arg->value && *(ListNode**)arg->value == NULL) {
-            free(arg->value);
-            arg->value = NULL;
-        }
+/* Records a stored value in the argument and in the set bitset used by validation. */
+static void mark_set(ArgParser* parser, Argument* arg) {
+    arg->set = true;
+    parser->set_bits[ARGPARSE_BIT_WORD(arg->index)] |= ARGPARSE_BIT_MASK(arg->index);
+}
 
-        APE_SET_MEMORY(arg_name);
-        return;
-    }
+/* Memory kept until argparse_reset() or argparse_free(): a lazily created pool (the arena of a view). */
+static ArgArena* retained_arena(ArgParser* parser) {
+    if (parser->overlay) return parser->arena;
 
-    /* node initialization */
-    new_node->data = value;
-    new_node->next = NULL;
+    if (!parser->string_pool)
+        parser->string_pool = argparse_arena_create_internal(0);
 
-    /* list insertion */
-    if (*head_ptr == NULL)
-        *head_ptr = new_node;
-    else {
-        /* non-empty list - append to tail */
-        ListNode* current = *head_ptr;
+    return parser->string_pool;
+}
 
-        /* O(n) but necessary for append */
-        while (current->next != NULL)
-            current = current->next;
+/* Copies a parsed string value; arena parsers copy into the retained pool, recycled by argparse_reset(). */
+static char* value_strdup(ArgParser* parser, const char* str) {
+    if (!parser->arena) return argparse_arena_strdup(NULL, str);
 
-        current->next = new_node;
-    }
+    ArgArena* pool = retained_arena(parser);
+    return pool ? argparse_arena_strdup(pool, str) : NULL;
 }
 
-static int list_length(ListNode* head) {
-    if (!head) return 0;
-    int count = 0;
+/* Storage for one string list element; ownership is decided while the list is empty. */
+static char* list_string(ArgParser* parser, Argument* arg, const char* str, size_t len,
+    bool terminated) {
+    if (arg->list_count == 0)
+        arg->borrowed = parser->borrow_strings;
+
+    /* borrowed lists point into the input, anything else is copied to retained memory */
+    if (arg->borrowed && terminated && parser->borrow_strings)
+        return (char*)str;
 
-    while (head) {
-        count++;
-        head = head->next;
+    /* only heap parsers free owned elements one by one, arena parsers recycle the pool */
+    bool pooled = arg->borrowed || parser->arena;
+    ArgArena* arena = pooled ? retained_arena(parser) : NULL;
+    char* copy = pooled && !arena ? NULL : (char*)argparse_arena_malloc(arena, len + 1);
+
+    if (!copy) {
+        const char* arg_name = arg->long_name ? arg->long_name :
+            arg->short_name ? arg->short_name :
+            "(unnamed)";
+        APE_SET_MEMORY(arg_name);
+        return NULL;
     }
 
-    return count;
+    memcpy(copy, str, len);
+    copy[len] = '\0';
+    ARGPARSE_STATS_ADD(bytes_copied, len);
+    return copy;
+}
+
+/* Releases a list element produced by list_string() that never made it into the list. */
+static void list_string_discard(ArgParser* parser, Argument* arg, char* str) {
+    if (!arg->borrowed)
+        argparse_arena_free(parser->arena, str);
+}
+
+/* Hands one element to a streaming list's callback instead of storing it. */
+static bool list_stream(Argument* arg, const void* element) {
+    ARGPARSE_STATS_ADD(list_elements, 1);
+
+    if (arg->callback(arg, element, arg->callback_data))
+        return true;
+
+    APE_SET(APE_VALIDATION, EINVAL, arg->long_name ? arg->long_name :
+        arg->short_name ? arg->short_name : "(unnamed)",
+        "List value rejected by callback.");
+    return false;
 }
 
 static bool get_safe_int(const char* str, int* out) {
@@ -240,6 +270,15 @@ static bool get_safe_int(const char* str, int* out) {
     while (isspace((unsigned char)*p)) p++;
     if (*p == '\0') return false;
 
+    /* plain decimal tokens never reach strtol */
+    size_t len = strlen(p);
+    int fast_value = 0;
+
+    if (argparse_number_parse_int_internal(p, len, &fast_value) == len) {
+        *out = fast_value;
+        return true;
+    }
+
     char* endptr; errno = 0;
     long val = strtol(p, &endptr, 10);
 
@@ -271,6 +310,15 @@ static bool get_safe_double(const char* str, double* out) {
     while (isspace((unsigned char)*p)) p++;
     if (*p == '\0') return false;
 
+    /* short decimal tokens convert exactly without strtod */
+    size_t len = strlen(p);
+    double fast_value = 0.0;
+
+    if (argparse_number_parse_double_internal(p, len, &fast_value) == len) {
+        *out = fast_value;
+        return true;
+    }
+
     char* endptr; errno = 0;
     double val = strtod(p, &endptr);
     if (endptr == p) return false;
@@ -293,7 +341,7 @@ static bool get_safe_double(const char* str, double* out) {
 }
 
 /* Parse list values using dynamic delimiter using zero allocations for parsing. */
-static void parse_list_with_delimiter(Argument* arg, const char* value_str) {
+static void parse_list_with_delimiter(ArgParser* parser, Argument* arg, const char* value_str) {
     /* save only error category, for future use */
     ArgParseErrorCategory prev_category = argparse_error_get_category();
 
@@ -311,6 +359,7 @@ static void parse_list_with_delimiter(Argument* arg, const char* value_str) {
 
     const char delimiter = arg->delimiter ? arg->delimiter : ' ';
     const char* start = value_str;
+    const char* value_end = value_str + strlen(value_str);
     int count = 0;
 
     while (*start) {
@@ -319,13 +368,49 @@ static void parse_list_with_delimiter(Argument* arg, const char* value_str) {
         if (!*start) break;
 
         /* find token end */
-        const char* end = start;
-        while (*end && *end != delimiter) end++;
+        const char* end = (const char*)memchr(start, delimiter, (size_t)(value_end - start));
+        if (!end) end = value_end;
 
         const size_t token_len = (size_t)(end - start);
         if (token_len == 0) break;
 
-        void* parsed_value = NULL;
+        /* bulk path: plain numbers convert straight into the list buffer; the
+           scanners may read ahead up to value_end but must stop at the delimiter */
+        if (arg->type == ARG_INT_LIST || arg->type == ARG_DOUBLE_LIST) {
+            const size_t avail = (size_t)(value_end - start);
+            int fast_int = 0;
+            double fast_double = 0.0;
+            bool fast = arg->type == ARG_INT_LIST
+                ? argparse_number_parse_int_internal(start, avail, &fast_int) == token_len
+                : argparse_number_parse_double_internal(start, avail, &fast_double) == token_len;
+
+            if (fast && arg->callback) {
+                if (arg->type == ARG_INT_LIST ? !list_stream(arg, &fast_int)
+                    : !list_stream(arg, &fast_double))
+                    return;
+
+                count++;
+                start = end;
+                continue;
+            }
+
+            if (fast) {
+                void* slot = list_push(parser, arg);
+                if (!slot) return;
+
+                if (arg->type == ARG_INT_LIST) *(int*)slot = fast_int;
+                else *(double*)slot = fast_double;
+
+                count++;
+                start = end;
+                continue;
+            }
+        }
+
+        int int_value = 0;
+        double double_value = 0.0;
+        char* string_value = NULL;
+        char stream_buf[128];
         bool valid = false;
 
         switch (arg->type) {
@@ -348,14 +433,7 @@ static void parse_list_with_delimiter(Argument* arg, const char* value_str) {
 
             memcpy(token_buf, start, token_len);
             token_buf[token_len] = '\0';
-            int* val = (int*)malloc(sizeof(int));
-
-            if (val && get_safe_int(token_buf, val)) {
-                parsed_value = val;
-                valid = true;
-            }
-            else if (val)
-                free(val);
+            valid = get_safe_int(token_buf, &int_value);
             break;
         }
         case ARG_DOUBLE_LIST: {
@@ -376,24 +454,35 @@ static void parse_list_with_delimiter(Argument* arg, const char* value_str) {
 
             memcpy(token_buf, start, token_len);
             token_buf[token_len] = '\0';
-            double* val = (double*)malloc(sizeof(double));
-
-            if (val && get_safe_double(token_buf, val)) {
-                parsed_value = val;
-                valid = true;
-            }
-            else if (val)
-                free(val);
+            valid = get_safe_double(token_buf, &double_value);
             break;
         }
         case ARG_STRING_LIST: {
-            char* val = (char*)malloc(token_len + 1);
-            if (val) {
-                memcpy(val, start, token_len);
-                val[token_len] = '\0';
-                parsed_value = val;
-                valid = true;
+            /* streamed slices only need to live for the callback */
+            if (!arg->callback)
+                string_value = list_string(parser, arg, start, token_len, false);
+            else if (token_len < sizeof(stream_buf))
+                string_value = stream_buf;
+            else
+                string_value = (char*)malloc(token_len + 1);
+
+            /* list_string() reports its own failures */
+            if (!string_value) {
+                if (arg->callback) {
+                    const char* arg_name = arg->long_name ? arg->long_name :
+                        arg->short_name ? arg->short_name :
+                        "(unnamed)";
+                    APE_SET_MEMORY(arg_name);
+                }
+                return;
+            }
+
+            if (arg->callback) {
+                memcpy(string_value, start, token_len);
+                string_value[token_len] = '\0';
             }
+
+            valid = true;
             break;
         }
         default: {
@@ -410,8 +499,27 @@ static void parse_list_with_delimiter(Argument* arg, const char* value_str) {
         }
         }
 
-        if (valid) {
-            append_to_list(arg, parsed_value);
+        if (valid && arg->callback) {
+            bool accepted = list_stream(arg, arg->type == ARG_INT_LIST ? (const void*)&int_value :
+                arg->type == ARG_DOUBLE_LIST ? (const void*)&double_value : string_value);
+
+            if (string_value != stream_buf)
+                free(string_value);
+
+            if (!accepted) return;
+            count++;
+        }
+        else if (valid) {
+            void* slot = list_push(parser, arg);
+
+            if (!slot) {
+                list_string_discard(parser, arg, string_value);
+                return;
+            }
+
+            if (arg->type == ARG_INT_LIST) *(int*)slot = int_value;
+            else if (arg->type == ARG_DOUBLE_LIST) *(double*)slot = double_value;
+            else *(char**)slot = string_value;
             count++;
         }
         else {
@@ -441,7 +549,7 @@ static void parse_list_with_delimiter(Argument* arg, const char* value_str) {
         return;
     }
 
-    arg->set = true;
+    mark_set(parser, arg);
 
     /* restore non-fatal previous error */
     if (prev_category != APE_SUCCESS && prev_category != APE_HELP_REQUESTED) {
@@ -451,29 +559,40 @@ static void parse_list_with_delimiter(Argument* arg, const char* value_str) {
     }
 }
 
-static void cleanup_partial_list(ListNode** head_ptr) {
-    if (!head_ptr || !*head_ptr) return;
-    ListNode* current = *head_ptr;
-
-    while (current) {
-        ListNode* next = current->next;
-        free(current->data);
-        free(current);
-        current = next;
-    }
-
-    *head_ptr = NULL;
+/* Tokens classified on the stack before falling back to the heap. */
+#define ARGPARSE_TOKEN_STACK 64
+
+/* Classification of one command-line token, decided exactly once per parse. */
+typedef enum ArgTokenKind {
+    TOKEN_VALUE,        /* Plain value (or anything after "--") */
+    TOKEN_OPTION,       /* Registered argument name */
+    TOKEN_OPTION_VALUE, /* GNU-style name<suffix>value */
+    TOKEN_HELP,         /* One of the accepted help spellings */
+    TOKEN_TERMINATOR    /* "--", ends option recognition */
+} ArgTokenKind;
+
+typedef struct ArgToken {
+    const char* text;   /* Original token */
+    const char* value;  /* Inline value for TOKEN_OPTION_VALUE */
+    Argument* arg;      /* Matched argument, NULL for plain values */
+    ArgTokenKind kind;
+} ArgToken;
+
+/* Unregistered help spellings (e.g. "-H") are accepted as values, like any other text. */
+static bool token_is_value(const ArgToken* token) {
+    return token->kind == TOKEN_VALUE ||
+        (token->kind == TOKEN_HELP && !token->arg);
 }
 
 /* Helper function to parse multiple values for list arguments. */
 static int parse_list_values(ArgParser* parser, Argument* arg,
-    int current_index, int argc, char** argv) {
+    int current_index, const ArgToken* tokens, int count) {
 
     /* clear any existing errors */
     argparse_error_clear();
 
     /* validate inputs */
-    if (!parser || !arg || !argv)
+    if (!parser || !arg || !tokens)
         return current_index;
 
     /* get the dynamic delimiter */
@@ -483,8 +602,13 @@ static int parse_list_values(ArgParser* parser, Argument* arg,
     int i = current_index + 1;
     int values_parsed = 0;
 
-    while (i < argc && !argparse_hash_find_argument(parser, argv[i])) {
-        const char* value = argv[i];
+    /* "--" right after the option introduces literal values */
+    if (i < count && tokens[i].kind == TOKEN_TERMINATOR)
+        i++;
+
+    /* classification already tells where the values stop, no lookups needed */
+    while (i < count && token_is_value(&tokens[i])) {
+        const char* value = tokens[i].text;
 
         /* check if value contains delimiter */
         if (delimiter != ' ') {
@@ -492,13 +616,11 @@ static int parse_list_values(ArgParser* parser, Argument* arg,
 
             if (delim_pos) {
                 /* parse as delimited string */
-                parse_list_with_delimiter(arg, value);
+                parse_list_with_delimiter(parser, arg, value);
 
                 /* clean up partially parsed list if any error occurred */
                 if (argparse_error_occurred()) { 
-                    if (arg->value)
-                        cleanup_partial_list(
-                            (ListNode**)arg->value);
+                    list_clear(parser, arg);
                     return current_index;
                 }
 
@@ -509,47 +631,47 @@ static int parse_list_values(ArgParser* parser, Argument* arg,
         }
 
         /* parse as single value */
-        void* parsed_value = NULL;
+        int int_value = 0;
+        double double_value = 0.0;
+        char* string_value = NULL;
         bool valid = false;
 
         switch (arg->type) {
-        case ARG_INT_LIST: {
-            int* val = (int*)malloc(sizeof(int));
-
-            if (val && get_safe_int(value, val)) {
-                parsed_value = val;
-                valid = true;
-            }
-            else if (val)
-                free(val);
+        case ARG_INT_LIST:
+            valid = get_safe_int(value, &int_value);
             break;
-        }
-        case ARG_DOUBLE_LIST: {
-            double* val = (double*)malloc(sizeof(double));
-
-            if (val && get_safe_double(value, val)) {
-                parsed_value = val;
-                valid = true;
-            }
-            else if (val)
-                free(val);
+        case ARG_DOUBLE_LIST:
+            valid = get_safe_double(value, &double_value);
             break;
-        }
-        case ARG_STRING_LIST: {
-            char* val = strdup(value);
+        case ARG_STRING_LIST:
+            string_value = arg->callback ? (char*)value
+                : list_string(parser, arg, value, strlen(value), true);
 
-            if (val) {
-                parsed_value = val;
-                valid = true;
-            }
+            /* out of memory, reported by list_string() */
+            if (!string_value) return current_index;
+            valid = true;
             break;
-        }
         default:
             break;
         }
 
-        if (valid) {
-            append_to_list(arg, parsed_value);
+        if (valid && arg->callback) {
+            if (!list_stream(arg, arg->type == ARG_INT_LIST ? (const void*)&int_value :
+                arg->type == ARG_DOUBLE_LIST ? (const void*)&double_value : string_value))
+                return current_index;
+            values_parsed++;
+        }
+        else if (valid) {
+            void* slot = list_push(parser, arg);
+
+            if (!slot) {
+                list_string_discard(parser, arg, string_value);
+                return current_index;
+            }
+
+            if (arg->type == ARG_INT_LIST) *(int*)slot = int_value;
+            else if (arg->type == ARG_DOUBLE_LIST) *(double*)slot = double_value;
+            else *(char**)slot = string_value;
             values_parsed++;
         }
         else {
@@ -571,21 +693,76 @@ static int parse_list_values(ArgParser* parser, Argument* arg,
         return current_index;
     }
 
-    arg->set = true;
+    mark_set(parser, arg);
     return i - 1;
 }
 
-ArgParser* argparse_new(const char* description) {
-    /* clear any existing errors */
-    argparse_error_clear();
-    ArgParser* parser = (ArgParser*)calloc(1, sizeof(ArgParser));
+/* Adds a suffix character to the parser's strpbrk set, once. */
+static void register_suffix(ArgParser* parser, char suffix) {
+    if (suffix == '\0' || strchr(parser->suffix_chars, suffix))
+        return;
 
-    if (!parser) {
-        APE_SET_MEMORY(NULL);
-        return NULL;
+    size_t used = strlen(parser->suffix_chars);
+    parser->suffix_chars[used] = suffix;
+    parser->suffix_chars[used + 1] = '\0';
+}
+
+/* The parser-owned default string, NULL for bound strings whose initial is the caller's. */
+static char* string_default(const Argument* arg) {
+    return arg->target ? NULL : arg->initial.as_string;
+}
+
+/* Records the value an argument starts with, once its storage is set up. */
+static void capture_initial(Argument* arg) {
+    switch (arg->type) {
+    case ARG_INT: arg->initial.as_int = *(const int*)arg->value; break;
+    case ARG_DOUBLE: arg->initial.as_double = *(const double*)arg->value; break;
+    case ARG_BOOL: arg->initial.as_bool = *(const bool*)arg->value; break;
+    case ARG_STRING:
+        arg->initial.as_string = arg->target ? *(char**)arg->target : (char*)arg->value;
+        break;
+    default:
+        break;
+    }
+}
+
+/* Allocate an argument's value storage, seeded from an optional default. */
+static bool init_argument_value(ArgParser* parser, Argument* arg, const void* default_value) {
+    /* scalars live inline, list buffers are allocated lazily on first append */
+    switch (arg->type) {
+    case ARG_INT:
+        arg->scalar.as_int = default_value ? *(const int*)default_value : 0;
+        arg->value = &arg->scalar.as_int;
+        break;
+
+    case ARG_DOUBLE:
+        arg->scalar.as_double = default_value ? *(const double*)default_value : 0.0;
+        arg->value = &arg->scalar.as_double;
+        break;
+
+    case ARG_BOOL:
+        arg->scalar.as_bool = default_value ? *(const bool*)default_value : false;
+        arg->value = &arg->scalar.as_bool;
+        break;
+
+    case ARG_STRING:
+        arg->value = argparse_arena_strdup(parser->arena, (const char*)default_value);
+        if (!arg->value && default_value) return false;
+        break;
+
+    default:
+        arg->value = NULL;
+        break;
     }
 
+    return true;
+}
+
+/* Shared constructor body; the parser memory is already zeroed. */
+static ArgParser* parser_init(ArgParser* parser, ArgArena* arena, const char* description,
+    bool add_help) {
     /* initialize all fields */
+    parser->arena = arena;
     parser->arguments = NULL;
     parser->program_name = NULL;
     parser->help_requested = false;
@@ -598,17 +775,22 @@ ArgParser* argparse_new(const char* description) {
 
     /* set the description */
     if (description) {
-        parser->description = strdup(description);
+        parser->description = argparse_arena_strdup(arena, description);
 
         if (!parser->description) {
+            /* argparse_free() resets the error state, report afterwards */
+            argparse_free(parser);
             APE_SET_MEMORY(NULL);
-            free(parser);
             return NULL;
         }
     }
     else
         parser->description = NULL;
 
+    /* spec parsers carry the help argument inside their static table */
+    if (!add_help)
+        return parser;
+
     /* automatically add help argument */
     argparse_add_argument(parser, "-h", "--help", ARG_BOOL,
         "Show this help message and exit", false, NULL);
@@ -622,271 +804,546 @@ ArgParser* argparse_new(const char* description) {
     return parser;
 }
 
-static void free_argument(Argument* arg) {
-    if (!arg) return;
+ArgParser* argparse_new(const char* description) {
+    /* clear any existing errors */
+    argparse_error_clear();
+    ArgParser* parser = (ArgParser*)calloc(1, sizeof(ArgParser));
+
+    if (!parser) {
+        APE_SET_MEMORY(NULL);
+        return NULL;
+    }
 
-    /* free string fields */
-    free(arg->short_name);
+    return parser_init(parser, NULL, description, true);
+}
 
-    free(arg->long_name);
-    free(arg->help);
+ArgParser* argparse_new_with_arena(const char* description) {
+    /* clear any existing errors */
+    argparse_error_clear();
+    ArgArena* arena = argparse_arena_create_internal(0);
 
-    /* free value based on type */
-    if (arg->value != NULL) {
-        switch (arg->type) {
-        case ARG_INT:
-        case ARG_DOUBLE:
-        case ARG_BOOL:
-            free(arg->value);
-            break;
+    if (!arena) return NULL;
 
-        case ARG_STRING:
-            free(arg->value);
-            break;
+    /* the parser itself lives in the arena it owns */
+    ArgParser* parser = (ArgParser*)argparse_arena_calloc(arena, 1, sizeof(ArgParser));
 
-        case ARG_INT_LIST:
-        case ARG_DOUBLE_LIST:
-        case ARG_STRING_LIST: {
-            ListNode* head = *(ListNode**)arg->value;
+    if (!parser) {
+        APE_SET_MEMORY(NULL);
+        argparse_arena_destroy_internal(arena);
+        return NULL;
+    }
 
-            /* free list nodes and their data */
-            while (head != NULL) {
-                ListNode* next = head->next;
+    return parser_init(parser, arena, description, true);
+}
 
-                /* free node data based on type */
-                free(head->data);
+ArgParser* argparse_new_from_spec(const char* description, const ArgSpec* specs,
+    size_t count, const ArgSpecIndex* index) {
+    /* clear any existing errors */
+    argparse_error_clear();
 
-                /* free the node itself */
-                free(head);
-                head = next;
-            }
+    if (!specs && count > 0) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Spec table is NULL.");
+        return NULL;
+    }
 
-            free(arg->value);
-            break;
-        }
-        }
+    /* a generated index is only valid for the table it was built from */
+    if (index && (index->version != ARGPARSE_SPEC_INDEX_VERSION ||
+        index->spec_count != count)) {
+        APE_SET(APE_CONFIG, EINVAL, NULL,
+            "Spec index does not match the spec table, regenerate it.");
+        return NULL;
     }
 
-    /* finally free the argument struct */
-    free(arg);
-}
+    for (size_t i = 0; i < count; i++) {
+        if ((!specs[i].short_name || specs[i].short_name[0] == '\0') &&
+            (!specs[i].long_name || specs[i].long_name[0] == '\0')) {
+            APE_SET(APE_INTERNAL, EINVAL, NULL,
+                "Both short and long names are empty.");
+            return NULL;
+        }
+    }
 
-/* High-performance help argument detection function without prefix dependency. */
-static bool is_help_argument(const char* arg_name) {
-    /* quick rejection of NULL or empty strings */
-    if (!arg_name || arg_name[0] == '\0')
-        return false;
+    /* build the perfect hash now unless one was generated ahead of time */
+    ArgSpecIndex* owned_index = NULL;
 
-    /* block all format string attacks */
-    if (strchr(arg_name, '%'))
-        return false;
+    if (!index) {
+        owned_index = argparse_spec_index_create(specs, count);
+        if (!owned_index) return NULL;
+        index = owned_index;
+    }
 
-    /* pre-computed list of accepted help arguments */
-    static const char* const patterns[] = {
-        "-h", "-H", "--help", "--HELP",
-        "/?", "/help", "/HELP", NULL
-    };
+    ArgParser* parser = (ArgParser*)calloc(1, sizeof(ArgParser));
 
-    /* linear scan through accepted forms, O(1) in practice */
-    for (const char* const* ptr = patterns; *ptr; ptr++) {
-        if (strcmp(arg_name, *ptr) == 0)
-            return true;
+    if (!parser) {
+        APE_SET_MEMORY(NULL);
+        argparse_spec_index_free(owned_index);
+        return NULL;
     }
 
-    return false;
-}
+    parser->owned_spec_index = owned_index;
+    if (!parser_init(parser, NULL, description, false))
+        return NULL;
 
-void argparse_add_argument(ArgParser* parser, const char* short_name, const char* long_name,
-    ArgType type, const char* help, bool required, void* default_value) {
-    argparse_error_clear();
+    /* one array for the whole table, help argument in the last slot */
+    Argument* args = (Argument*)calloc(count + 1, sizeof(Argument));
+
+    if (!args) {
+        argparse_free(parser);
+        APE_SET_MEMORY(NULL);
+        return NULL;
+    }
+
+    Argument* help = &args[count];
+    help->short_name = (char*)"-h";
+    help->long_name = (char*)"--help";
+    help->help = (char*)"Show this help message and exit";
+    help->type = ARG_BOOL;
+    help->delimiter = ' ';
+    help->from_spec = true;
+    help->owner = parser;
+
+    /* help comes first, exactly as with argparse_new() */
+    parser->spec_arguments = args;
+    parser->spec_index = index;
+    parser->arguments = help;
+    parser->spec_tail = help;
+
+    for (size_t i = 0; i < count; i++) {
+        Argument* arg = &args[i];
+
+        /* names and help are borrowed from the static table */
+        arg->short_name = (char*)specs[i].short_name;
+        arg->long_name = (char*)specs[i].long_name;
+        arg->help = (char*)specs[i].help;
+        arg->type = specs[i].type;
+        arg->required = specs[i].required;
+        arg->is_list = is_list_type(specs[i].type);
+        arg->suffix = (unsigned char)specs[i].suffix;
+        register_suffix(parser, specs[i].suffix);
+        arg->delimiter = specs[i].delimiter
+            ? (unsigned char)specs[i].delimiter : ' ';
+        arg->from_spec = true;
+        arg->owner = parser;
+
+        parser->spec_tail->next = arg;
+        parser->spec_tail = arg;
+    }
+
+    parser->tail = parser->spec_tail;
+
+    /* value storage is allocated once the list is consistent for argparse_free() */
+    size_t position = 0;
+
+    for (Argument* arg = parser->arguments; arg; arg = arg->next) {
+        arg->index = position++;
+
+        if (!argparse_rules_index_internal(parser, arg->index, arg->required, false) ||
+            !init_argument_value(parser, arg, arg == help
+            ? NULL : specs[arg - args].default_value)) {
+            /* names are borrowed from the table, so they outlive the parser */
+            const char* arg_name = arg->short_name ? arg->short_name : arg->long_name;
+            argparse_free(parser);
+            APE_SET_MEMORY(arg_name);
+            return NULL;
+        }
+
+        capture_initial(arg);
+    }
+
+    return parser;
+}
+
+static void free_argument_value(ArgParser* parser, Argument* arg) {
+    ArgArena* arena = parser->arena;
+
+    /* bound scalars point into caller storage */
+    if (arg->target && arg->value == arg->target)
+        return;
+
+    if (arg->type == ARG_STRING)
+        argparse_arena_free(arena, string_default(arg));
+
+    /* free value based on type, scalars are stored inline */
+    if (arg->value != NULL) {
+        switch (arg->type) {
+        case ARG_INT:
+        case ARG_DOUBLE:
+        case ARG_BOOL:
+            break;
+
+        case ARG_STRING:
+            if (!arg->borrowed && arg->value != string_default(arg))
+                argparse_arena_free(arena, arg->value);
+            break;
+
+        case ARG_INT_LIST:
+        case ARG_DOUBLE_LIST:
+        case ARG_STRING_LIST:
+            /* release owned strings, then the contiguous buffer */
+            list_clear(parser, arg);
+            argparse_arena_free(arena, arg->value);
+            break;
+        }
+    }
+}
+
+
+/* High-performance help argument detection function without prefix dependency. */
+static bool is_help_argument(const char* arg_name) {
+    /* quick rejection of NULL or empty strings */
+    if (!arg_name || arg_name[0] == '\0')
+        return false;
+
+    /* block all format string attacks */
+    if (strchr(arg_name, '%'))
+        return false;
+
+    /* pre-computed list of accepted help arguments */
+    static const char* const patterns[] = {
+        "-h", "-H", "--help", "--HELP",
+        "/?", "/help", "/HELP", NULL
+    };
+
+    /* linear scan through accepted forms, O(1) in practice */
+    for (const char* const* ptr = patterns; *ptr; ptr++) {
+        if (strcmp(arg_name, *ptr) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+void argparse_set_seed_policy(ArgParser* parser, ArgHashSeedPolicy policy) {
+    argparse_error_clear();
+
+    if (!parser) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
+        return;
+    }
+
+    if (policy != ARGPARSE_SEED_SECURE && policy != ARGPARSE_SEED_PROCESS &&
+        policy != ARGPARSE_SEED_FIXED) {
+        APE_SET(APE_CONFIG, EINVAL, NULL, "Unknown seed policy.");
+        return;
+    }
+
+    parser->seed_policy = policy;
+}
+
+void argparse_set_flags(ArgParser* parser, unsigned flags) {
+    argparse_error_clear();
 
-    /* validate parser parameter */
     if (!parser) {
         APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
         return;
     }
 
+    if (flags & ~(ARGPARSE_BORROW_ARGV | ARGPARSE_RESPONSE_FILES | ARGPARSE_ALLOW_ABBREV |
+        ARGPARSE_COMPLETION)) {
+        APE_SET(APE_CONFIG, EINVAL, NULL, "Unknown parser flags.");
+        return;
+    }
+
+    parser->flags = flags;
+}
+
+/*
+ * Shared body of the add functions, configures the argument completely before linking it
+ * in O(1); returns the new argument, NULL on error or skipped help.
+ */
+static Argument* add_argument(ArgParser* parser, const char* short_name, const char* long_name,
+    ArgType type, const char* help, bool required, void* default_value, void* target,
+    char suffix, char delimiter) {
+    argparse_error_clear();
+
+    /* validate parser parameter */
+    if (!parser) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
+        return NULL;
+    }
+
     /* don't add duplicate help arguments */
     if (parser->help_added && ((short_name && is_help_argument(short_name)) ||
         (long_name && is_help_argument(long_name))))
-        return;
+        return NULL;
 
     /* validate argument names */
     if ((!short_name || short_name[0] == '\0') &&
         (!long_name || long_name[0] == '\0')) {
         APE_SET(APE_INTERNAL, EINVAL, NULL,
             "Both short and long names are empty.");
-        return;
+        return NULL;
     }
 
     /* get argument name for error reporting */
     const char* arg_name = short_name ? short_name :
         long_name ? long_name : "(unnamed)";
 
-    /* alloc argument structure */
-    Argument* arg = (Argument*)malloc(sizeof(Argument));
+    /* nodes are packed back to back, names and help are stored once per parser */
+    if (!parser->nodes &&
+        !(parser->nodes = argparse_arena_create_internal(ARGPARSE_NODE_BLOCK_ARGS * sizeof(Argument))))
+        return NULL;
+
+    if (!parser->names && !(parser->names = argparse_intern_pool_create_internal()))
+        return NULL;
+
+    Argument* arg = (Argument*)argparse_arena_malloc(parser->nodes, sizeof(Argument));
     if (!arg) {
         APE_SET_MEMORY(arg_name);
-        return;
+        return NULL;
     }
 
     /* init all fields to known state */
     memset(arg, 0, sizeof(Argument));
+    arg->owner = parser;
     arg->required = required;
     arg->type = type;
     arg->is_list = is_list_type(type);
-    arg->delimiter = ' ';
+    arg->suffix = (unsigned char)suffix;
+    arg->delimiter = delimiter ? (unsigned char)delimiter : ' ';
 
-    /* duplicate strings with immediate error checking */
-    if (short_name && !(arg->short_name = strdup(short_name))) goto memory_error;
-    if (long_name && !(arg->long_name = strdup(long_name))) goto memory_error;
-    if (help && !(arg->help = strdup(help))) goto memory_error;
+    /* intern strings with immediate error checking */
+    ArgInternPool* names = parser->names;
+    if (short_name && !(arg->short_name = argparse_intern_internal(names, short_name))) goto memory_error;
+    if (long_name && !(arg->long_name = argparse_intern_internal(names, long_name))) goto memory_error;
+    if (help && !(arg->help = argparse_intern_internal(names, help))) goto memory_error;
 
-    /* handle default value allocation */
-    if (default_value) {
-        switch (type) {
-        case ARG_INT:
-            if (!(arg->value = malloc(sizeof(int)))) goto memory_error;
-            *(int*)arg->value = *(int*)default_value;
-            break;
-
-        case ARG_DOUBLE:
-            if (!(arg->value = malloc(sizeof(double)))) goto memory_error;
-            *(double*)arg->value = *(double*)default_value;
-            break;
+    /* bound scalars live in caller storage, strings are owned and mirrored there */
+    arg->target = target;
 
-        case ARG_STRING:
-            arg->value = strdup((char*)default_value);
-            if (!arg->value && default_value) goto memory_error;
-            break;
+    if (target && type != ARG_STRING)
+        arg->value = target;
+    else if (!init_argument_value(parser, arg, default_value))
+        goto memory_error;
 
-        case ARG_BOOL:
-            if (!(arg->value = malloc(sizeof(bool)))) goto memory_error;
-            *(bool*)arg->value = *(bool*)default_value;
-            break;
+    capture_initial(arg);
 
-        default:
-            arg->value = create_default_value(type);
-            if (!arg->value && type != ARG_STRING) goto memory_error;
-            break;
-        }
-    }
-    else {
-        arg->value = create_default_value(type);
-        if (!arg->value && type != ARG_STRING) goto memory_error;
-    }
+    /* dense index in list order, its bitset slots exist before the argument is linked */
+    arg->index = parser->tail ? parser->tail->index + 1 : 0;
+    if (!argparse_rules_index_internal(parser, arg->index, required, target != NULL))
+        goto memory_error;
 
-    /* add to linked list - maintain tail for O(1) append */
-    if (!parser->arguments) {
+    /* append after the tail, no walk over the list */
+    if (!parser->tail)
         parser->arguments = arg;
-    }
-    else {
-        Argument* tail = parser->arguments;
-        while (tail->next) tail = tail->next;
-        tail->next = arg;
-    }
+    else
+        parser->tail->next = arg;
+
+    parser->tail = arg;
+    register_suffix(parser, suffix);
+    invalidate_help(parser);
 
     /* handle hash table integration */
     insert_argument_into_hash_table(parser, arg);
-    return;
+    return arg;
 
 memory_error:
+    /* the node and any interned names stay in their pools until argparse_free() */
     APE_SET_MEMORY(arg_name);
-    free_argument(arg);
+    free_argument_value(parser, arg);
+    return NULL;
 }
 
-void argparse_add_argument_ex(ArgParser* parser, const char* short_name, const char* long_name,
-    ArgType type, const char* help, bool required, void* default_value, char suffix) {
+/* Adds a suffixed, delimited list argument in one step. */
+static Argument* add_list_argument_ex(ArgParser* parser, const char* short_name, const char* long_name,
+    ArgType list_type, const char* help, bool required, char suffix, char delimiter) {
     argparse_error_clear();
 
     if (!parser) {
         APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
-        return;
+        return NULL;
+    }
+
+    if (!is_list_type(list_type)) {
+        const char* arg_name = short_name ? short_name :
+            long_name ? long_name : "(unnamed)";
+        APE_SET(APE_INTERNAL, EINVAL, arg_name, "Invalid list type.");
+        return NULL;
+    }
+
+    return add_argument(parser, short_name, long_name, list_type,
+        help, required, NULL, NULL, suffix, delimiter);
+}
+
+void argparse_add_argument(ArgParser* parser, const char* short_name, const char* long_name,
+    ArgType type, const char* help, bool required, void* default_value) {
+    (void)add_argument(parser, short_name, long_name, type, help, required, default_value, NULL, 0, 0);
+}
+
+ArgHandle argparse_add_argument_handle(ArgParser* parser, const char* short_name,
+    const char* long_name, ArgType type, const char* help, bool required, void* default_value) {
+    return add_argument(parser, short_name, long_name, type, help, required, default_value, NULL, 0, 0);
+}
+
+ArgHandle argparse_add_argument_ex_handle(ArgParser* parser, const char* short_name,
+    const char* long_name, ArgType type, const char* help, bool required, void* default_value,
+    char suffix) {
+    return add_argument(parser, short_name, long_name, type, help, required,
+        default_value, NULL, suffix, 0);
+}
+
+ArgHandle argparse_add_list_argument_handle(ArgParser* parser, const char* short_name,
+    const char* long_name, ArgType list_type, const char* help, bool required, char suffix,
+    char delimiter) {
+    return add_list_argument_ex(parser, short_name, long_name, list_type, help, required,
+        suffix, delimiter);
+}
+
+ArgHandle argparse_add_list_argument_cb(ArgParser* parser, const char* short_name,
+    const char* long_name, ArgType list_type, const char* help, bool required, char suffix,
+    char delimiter, ArgListCallback callback, void* user_data) {
+    if (!callback) {
+        argparse_error_clear();
+        APE_SET(APE_CONFIG, EINVAL, long_name ? long_name : short_name,
+            "List callback is NULL.");
+        return NULL;
     }
 
-    /* use existing memory allocation */
-    argparse_add_argument(parser, short_name, long_name, type, help, required, default_value);
-    if (argparse_error_occurred()) return;
+    Argument* arg = add_list_argument_ex(parser, short_name, long_name, list_type, help,
+        required, suffix, delimiter);
 
-    /* find the last added argument efficiently */
-    Argument* arg = parser->arguments;
-    Argument* last = NULL;
+    if (arg) {
+        arg->callback = callback;
+        arg->callback_data = user_data;
 
-    while (arg) {
-        last = arg;
-        arg = arg->next;
+        /* streamed elements must reach the callback even when a fallback supplies them */
+        parser->eager_bits[ARGPARSE_BIT_WORD(arg->index)] |= ARGPARSE_BIT_MASK(arg->index);
     }
 
-    if (last)
-        last->suffix = suffix;
+    return arg;
 }
 
-/* Single-pass GNU-style argument detector with dynamic suffix. */
-static Argument* is_gnu_argument(ArgParser* parser, const char* arg_str, const char** value_ptr) {
-    /* clear any existing errors at entry */
+ArgHandle argparse_add_argument_bind_ex(ArgParser* parser, const char* short_name,
+    const char* long_name, ArgType type, const char* help, bool required, void* target,
+    char suffix) {
     argparse_error_clear();
 
-    if (!parser || !arg_str || !value_ptr) {
-        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parameters to GNU argument detection.");
+    const char* arg_name = short_name ? short_name :
+        long_name ? long_name : "(unnamed)";
+
+    if (!target) {
+        APE_SET(APE_INTERNAL, EINVAL, arg_name, "Bind target is NULL.");
         return NULL;
     }
 
-    *value_ptr = NULL;
+    if (is_list_type(type)) {
+        APE_SET(APE_INTERNAL, EINVAL, arg_name, "List arguments cannot be bound.");
+        return NULL;
+    }
 
-    /* get all arguments that might match */
-    Argument* current = parser->arguments;
+    return add_argument(parser, short_name, long_name, type, help, required,
+        NULL, target, suffix, 0);
+}
 
-    while (current) {
-        /* skip arguments without GNU-style enabled */
-        if (current->suffix == 0) {
-            current = current->next;
-            continue;
-        }
+ArgHandle argparse_add_argument_bind(ArgParser* parser, const char* short_name,
+    const char* long_name, ArgType type, const char* help, bool required, void* target) {
+    return argparse_add_argument_bind_ex(parser, short_name, long_name, type, help,
+        required, target, 0);
+}
 
-        /* look for this argument's specific suffix char */
-        const char* suffix_pos = strchr(arg_str, current->suffix);
+ArgHandle argparse_bind_int(ArgParser* parser, const char* short_name, const char* long_name,
+    const char* help, bool required, int* target) {
+    return argparse_add_argument_bind(parser, short_name, long_name, ARG_INT, help, required, target);
+}
 
-        if (!suffix_pos) {
-            current = current->next;
-            continue;
-        }
+ArgHandle argparse_bind_double(ArgParser* parser, const char* short_name, const char* long_name,
+    const char* help, bool required, double* target) {
+    return argparse_add_argument_bind(parser, short_name, long_name, ARG_DOUBLE, help, required, target);
+}
 
-        /* compute total length before suffix */
-        size_t total_len = (size_t)(suffix_pos - arg_str);
+ArgHandle argparse_bind_bool(ArgParser* parser, const char* short_name, const char* long_name,
+    const char* help, bool required, bool* target) {
+    return argparse_add_argument_bind(parser, short_name, long_name, ARG_BOOL, help, required, target);
+}
 
-        if (total_len == 0) {
-            current = current->next;
-            continue;
-        }
+ArgHandle argparse_bind_string(ArgParser* parser, const char* short_name, const char* long_name,
+    const char* help, bool required, const char** target) {
+    return argparse_add_argument_bind(parser, short_name, long_name, ARG_STRING, help, required,
+        (void*)target);
+}
+
+void argparse_add_argument_ex(ArgParser* parser, const char* short_name, const char* long_name,
+    ArgType type, const char* help, bool required, void* default_value, char suffix) {
+    (void)add_argument(parser, short_name, long_name, type, help, required,
+        default_value, NULL, suffix, 0);
+}
 
-        /* create argument name string for hash lookup */
-        char* arg_name = (char*)malloc(total_len + 1);
+/*
+ * Resolves an abbreviated long option through the sorted name index: NULL when nothing
+ * starts with the prefix, and NULL with APE_SYNTAX set when several arguments do.
+ */
+static Argument* find_abbreviation(ArgParser* parser, const char* name, size_t len) {
+    if (!(parser->flags & ARGPARSE_ALLOW_ABBREV) || len <= 2 || strncmp(name, "--", 2) != 0)
+        return NULL;
 
-        if (!arg_name) {
-            APE_SET_MEMORY(NULL);
-            return NULL;
+    const ArgNameIndex* index = argparse_hash_name_index(parser);
+    if (!index) return NULL;
+
+    size_t first;
+    size_t matches = argparse_name_index_prefix_internal(index, name + 2, len - 2, &first);
+    const ArgNameEntry* entries = &index->entries[first];
+    const ArgNameEntry* found = NULL;
+    size_t candidates = 0;
+
+    /* only long names are abbreviated, "-v" also has the stem "v" */
+    for (size_t i = 0; i < matches; i++) {
+        if (entries[i].stem - entries[i].name != 2) continue;
+
+        if (!found) found = &entries[i];
+        else if (entries[i].argument != found->argument && candidates++ == 0) {
+            /* name the first two candidates, the full list is in the help */
+            char hint[160];
+            snprintf(hint, sizeof(hint), "could be '%s' or '%s'", found->name, entries[i].name);
+
+            APE_SET(APE_SYNTAX, EINVAL, name, "Ambiguous option abbreviation.");
+            argparse_error_set_hint(hint);
         }
+    }
 
-        memcpy(arg_name, arg_str, total_len);
-        arg_name[total_len] = '\0';
+    return found && !candidates ? found->argument : NULL;
+}
 
-        /* fast hash table lookup for argument name */
-        Argument* found_arg = argparse_hash_find_argument(parser, arg_name);
-        free(arg_name);
+/* Single-pass GNU-style argument detector, walks only the distinct suffix characters. */
+static Argument* is_gnu_argument(ArgParser* parser, const char* arg_str, const char** value_ptr) {
+    /* clear any existing errors at entry */
+    argparse_error_clear();
 
-        /* if lookup failed, propagate error */
-        if (argparse_error_occurred())
-            return NULL;
+    if (!parser || !arg_str || !value_ptr) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parameters to GNU argument detection.");
+        return NULL;
+    }
 
-        /* check if it was found the right argument */
-        if (found_arg != current) {
-            current = current->next;
-            continue;
+    *value_ptr = NULL;
+
+    /* no argument uses a suffix, nothing can match */
+    if (parser->suffix_chars[0] == '\0')
+        return NULL;
+
+    const char* suffix_pos = strpbrk(arg_str, parser->suffix_chars);
+
+    while (suffix_pos) {
+        size_t total_len = (size_t)(suffix_pos - arg_str);
+        char suffix = *suffix_pos;
+
+        /* an argument splits at the first occurrence of its own suffix only */
+        if (total_len > 0 && !memchr(arg_str, suffix, total_len)) {
+            /* slice lookup, the name is never copied */
+            Argument* found_arg = argparse_hash_find_argument_n(parser, arg_str, total_len);
+
+            if (!found_arg && !argparse_error_occurred())
+                found_arg = find_abbreviation(parser, arg_str, total_len);
+
+            /* if lookup failed, propagate error */
+            if (argparse_error_occurred())
+                return NULL;
+
+            if (found_arg && found_arg->suffix == (unsigned char)suffix) {
+                *value_ptr = suffix_pos + 1;
+                return found_arg;
+            }
         }
 
-        /* all checks passed */
-        *value_ptr = suffix_pos + 1;
-        return current;
+        suffix_pos = strpbrk(suffix_pos + 1, parser->suffix_chars);
     }
 
     return NULL;
@@ -901,51 +1358,16 @@ void argparse_add_list_argument(ArgParser* parser, const char* short_name, const
         return;
     }
 
-    argparse_add_argument(parser, short_name, long_name, list_type, help, required, NULL);
+    (void)add_argument(parser, short_name, long_name, list_type, help, required, NULL, NULL, 0, 0);
 }
 
 void argparse_add_list_argument_ex(ArgParser* parser, const char* short_name, const char* long_name,
     ArgType list_type, const char* help, bool required, char suffix, char delimiter) {
-    argparse_error_clear();
-
-    if (!parser) {
-        APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
-        return;
-    }
-
-    if (!is_list_type(list_type)) {
-        const char* arg_name = short_name ? short_name :
-            long_name ? long_name : "(unnamed)";
-        APE_SET(APE_INTERNAL, EINVAL, arg_name, "Invalid list type.");
-        return;
-    }
-
-    argparse_add_argument_ex(parser, short_name, long_name, list_type,
-        help, required, NULL, suffix);
-
-    /* an existing error is thrown, stop the execution */
-    if (argparse_error_occurred())
-        return;
-
-    /* find and set the delimiter */
-    Argument* arg = parser->arguments;
-    Argument* last = NULL;
-
-    while (arg) {
-        last = arg;
-        arg = arg->next;
-    }
-
-    if (last)
-        last->delimiter = delimiter;
-    else {
-        const char* arg_name = short_name ? short_name :
-            long_name ? long_name : "(unnamed)";
-        APE_SET(APE_INTERNAL, EINVAL, arg_name, "No arguments in parser.");
-    }
+    (void)add_list_argument_ex(parser, short_name, long_name, list_type, help, required,
+        suffix, delimiter);
 }
 
-static void parse_single_value(Argument* arg, const char* str_val) {
+static void parse_single_value(ArgParser* parser, Argument* arg, const char* str_val) {
     argparse_error_clear();
 
     /* validate the inputs */
@@ -1014,17 +1436,24 @@ static void parse_single_value(Argument* arg, const char* str_val) {
         break;
 
     case ARG_STRING: {
-        char* new_value = strdup(str_val);
+        /* borrowed values point straight into the input */
+        bool borrow = parser->borrow_strings;
+        char* new_value = borrow ? (char*)str_val : value_strdup(parser, str_val);
         if (!new_value) {
             APE_SET_MEMORY(arg_name);
             return;
         }
 
-        /* Free previous value if it exists */
-        if (arg->value)
-            free(arg->value);
+        /* free the previous value if owned, the default stays for argparse_reset() */
+        if (arg->value && !arg->borrowed && arg->value != string_default(arg))
+            argparse_arena_free(parser->arena, arg->value);
 
         arg->value = new_value;
+        arg->borrowed = borrow;
+
+        /* mirror into the bound pointer; it stays valid until the next value or argparse_reset() */
+        if (arg->target)
+            *(const char**)arg->target = new_value;
         break;
     }
 
@@ -1091,89 +1520,451 @@ static void parse_single_value(Argument* arg, const char* str_val) {
         return;
     }
 
-    arg->set = true;
+    mark_set(parser, arg);
 }
 
-void argparse_parse(ArgParser* parser, int argc, char** argv) {
-    argparse_error_clear();
+/* Name used in fallback sources: the long name without dashes, else the short one. */
+static const char* source_name(const Argument* arg) {
+    const char* name = arg->long_name && arg->long_name[0] ? arg->long_name : arg->short_name;
+    if (!name) return NULL;
 
-    /* check for valid inputs */
-    if (!parser || !argv) {
-        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser or argv.");
-        APE_RETURN_IF_ERROR(parser);
-        return;
-    }
+    while (*name == '-') name++;
+    return *name ? name : NULL;
+}
 
-    /* store program name */
-    if (parser->program_name != NULL)
-        free(parser->program_name);
+/* File keys compare with '-' and '_' as the same character. */
+static int source_key_char(char c) {
+    return c == '_' ? '-' : (unsigned char)c;
+}
 
-    parser->program_name = strdup(argv[0]);
-    if (!parser->program_name) {
-        APE_SET_MEMORY("program_name");
-        APE_RETURN_IF_ERROR(parser);
-        return;
+static int source_key_compare(const char* a, const char* b) {
+    while (*a && source_key_char(*a) == source_key_char(*b)) {
+        a++;
+        b++;
     }
 
-    /* check if no arguments were provided */
-    if (argc == 1) {
-        argparse_print_help(parser);
-        APE_SET(APE_HELP_REQUESTED, 0, NULL, "No arguments provided, showing help.");
-        APE_RETURN_IF_ERROR(parser);
-        return;
-    }
+    return source_key_char(*a) - source_key_char(*b);
+}
 
-    /* process command line arguments */
-    for (int i = 1; i < argc; i++) {
-        const char* current_arg = argv[i];
+static int source_key_order(const void* a, const void* b) {
+    const char* left = *(const char* const*)a;
+    const char* right = *(const char* const*)b;
+    int order = source_key_compare(left, right);
 
-        /* GNU-style argument detection */
-        const char* gnu_value = NULL;
-        Argument* gnu_arg = is_gnu_argument(parser, current_arg, &gnu_value);
+    /* equal keys keep file order, so the last assignment sorts last */
+    return order ? order : (left < right ? -1 : left > right);
+}
+
+/* Raw value of one source for the given name, NULL when it has none. */
+static const char* source_lookup(const ArgSource* source, const char* name) {
+    if (source->kind == ARGPARSE_SOURCE_ENV) {
+        char variable[256];
+        size_t prefix_len = strlen(source->prefix), len = strlen(name);
+
+        if (prefix_len + len >= sizeof(variable)) return NULL;
+
+        memcpy(variable, source->prefix, prefix_len);
+        for (size_t i = 0; i < len; i++)
+            variable[prefix_len + i] = name[i] == '-' ? '_' : (char)toupper((unsigned char)name[i]);
+        variable[prefix_len + len] = '\0';
+
+        return getenv(variable);
+    }
+
+    /* upper bound, then step back onto the last equal key */
+    size_t low = 0, high = source->key_count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+
+        if (source_key_compare(source->keys[mid], name) <= 0) low = mid + 1;
+        else high = mid;
+    }
+
+    if (low == 0 || source_key_compare(source->keys[low - 1], name) != 0)
+        return NULL;
+
+    const char* key = source->keys[low - 1];
+    return key + strlen(key) + 1;
+}
+
+/* Fills an unset argument from the first source that has it, at most once per argument. */
+static bool resolve_fallback(Argument* arg) {
+    ArgParser* parser = arg->owner;
+    if (!parser || !parser->sources) return false;
+
+    arg->resolved = true;
+
+    const char* name = source_name(arg);
+    if (!name) return false;
+
+    for (const ArgSource* source = parser->sources; source; source = source->next) {
+        const char* value = source_lookup(source, name);
+        if (!value) continue;
+
+        /* file words live until argparse_free(), the environment may change under us */
+        bool borrow = parser->borrow_strings;
+        parser->borrow_strings = source->kind == ARGPARSE_SOURCE_FILE;
+
+        if (arg->is_list)
+            parse_list_with_delimiter(parser, arg, value);
+        else
+            parse_single_value(parser, arg, value);
+
+        parser->borrow_strings = borrow;
+        break;
+    }
+
+    return arg->set;
+}
+
+/* True when argv or, on first use, a fallback source supplied the value. */
+static bool is_value_set(Argument* arg) {
+    return arg->set || (!arg->resolved && resolve_fallback(arg));
+}
+
+bool argparse_add_source(ArgParser* parser, ArgSourceKind kind, const char* location) {
+    argparse_error_clear();
+
+    if (!parser || !location || (kind != ARGPARSE_SOURCE_ENV && kind != ARGPARSE_SOURCE_FILE)) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser or source.");
+        return false;
+    }
+
+    ArgArena* arena = parser->arena;
+    ArgSource* source = (ArgSource*)argparse_arena_calloc(arena, 1, sizeof(ArgSource));
+
+    if (!source) {
+        APE_SET_MEMORY(location);
+        return false;
+    }
+
+    source->kind = kind;
+
+    if (kind == ARGPARSE_SOURCE_ENV) {
+        if (!(source->prefix = argparse_arena_strdup(arena, location)))
+            goto memory_error;
+    }
+    else {
+        /* read and sort once, later lookups only read and are safe from any thread */
+        if (!(source->entries = argparse_file_load_internal(location))) {
+            argparse_arena_free(arena, source);
+            return false;
+        }
+
+        ArgWords* entries = source->entries;
+        argparse_words_split_config_internal(entries->data, entries->size, &entries->count);
+        source->key_count = entries->count / 2;
+
+        if (source->key_count > 0) {
+            size_t alloc_size;
+
+            if (!safe_multiply_size_t(source->key_count, sizeof(char*), &alloc_size) ||
+                !(source->keys = (const char**)argparse_arena_malloc(arena, alloc_size)))
+                goto memory_error;
+
+            const char* word = entries->data;
+
+            for (size_t i = 0; i < source->key_count; i++) {
+                source->keys[i] = word;
+                word += strlen(word) + 1;
+                word += strlen(word) + 1;
+            }
+
+            qsort((void*)source->keys, source->key_count, sizeof(char*), source_key_order);
+        }
+    }
+
+    if (parser->sources_tail) parser->sources_tail->next = source;
+    else parser->sources = source;
+    parser->sources_tail = source;
+    return true;
+
+memory_error:
+    argparse_words_free_internal(source->entries);
+    argparse_arena_free(arena, source->prefix);
+    argparse_arena_free(arena, source);
+    APE_SET_MEMORY(location);
+    return false;
+}
+
+/* Maps a schema argument to its per-result copy when parsing through a result view. */
+static Argument* resolve_argument(const ArgParser* parser, Argument* arg) {
+    return arg && parser->overlay ? &parser->overlay[arg->index] : arg;
+}
+
+/* Classifies one token; returns false once an error is pending. */
+static bool classify_token(ArgParser* parser, const char* text, ArgToken* token, bool* options_ended) {
+    token->text = text;
+    token->value = NULL;
+    token->arg = NULL;
+    token->kind = TOKEN_VALUE;
+
+    /* everything after "--" is taken literally */
+    if (*options_ended)
+        return true;
+
+    if (strcmp(text, "--") == 0) {
+        token->kind = TOKEN_TERMINATOR;
+        *options_ended = true;
+        return true;
+    }
+
+    /* GNU-style argument detection */
+    ARGPARSE_STATS_START(gnu_start);
+    token->arg = resolve_argument(parser, is_gnu_argument(parser, text, &token->value));
+    ARGPARSE_STATS_STOP(gnu_start, ARGPARSE_PHASE_GNU);
+
+    /* lookups below reset the error state, stop while it is visible */
+    if (argparse_error_occurred())
+        return false;
+
+    if (token->arg) {
+        token->kind = TOKEN_OPTION_VALUE;
+        return true;
+    }
+
+    /* an empty token can only be a value */
+    if (text[0] == '\0')
+        return true;
+
+    /* single efficient lookup, cached for the processing pass */
+    ARGPARSE_STATS_START(lookup_start);
+    token->arg = resolve_argument(parser, argparse_hash_find_argument(parser, text));
+    ARGPARSE_STATS_STOP(lookup_start, ARGPARSE_PHASE_LOOKUP);
 
-        if (gnu_arg) {
+    if (is_help_argument(text))
+        token->kind = TOKEN_HELP;
+    else if (token->arg)
+        token->kind = TOKEN_OPTION;
+    else if ((token->arg = resolve_argument(parser, find_abbreviation(parser, text, strlen(text))))) {
+        /* "--he" spells out the built-in help like "--help" does */
+        token->kind = parser->help_added && is_help_argument(token->arg->long_name)
+            ? TOKEN_HELP : TOKEN_OPTION;
+    }
+    else if (argparse_error_occurred())
+        return false;
+
+    return true;
+}
+
+/* Classifies the words of a block in order, they are packed back to back. */
+static ArgToken* classify_words(ArgParser* parser, const ArgWords* words, ArgToken* token,
+    bool* options_ended) {
+    const char* text = words->data;
+
+    for (size_t i = 0; i < words->count; i++) {
+        if (!classify_token(parser, text, token++, options_ended))
+            return NULL;
+        text += strlen(text) + 1;
+    }
+
+    return token;
+}
+
+/*
+ * Classify every token once: GNU form, help, registered name, terminator or value.
+ * Covers argv[1..], with argv[i] replaced by the words of expanded[i] where set,
+ * followed by the words of trailing (NULL if none).
+ */
+static void tokenize_arguments(ArgParser* parser, int argc, char** argv, ArgWords** expanded,
+    const ArgWords* trailing, ArgToken* tokens) {
+    bool options_ended = false;
+    ArgToken* token = tokens;
+
+    for (int i = 1; i < argc && token; i++) {
+        if (expanded && expanded[i])
+            token = classify_words(parser, expanded[i], token, &options_ended);
+        else if (!classify_token(parser, argv[i], token++, &options_ended))
+            return;
+    }
+
+    if (token && trailing)
+        classify_words(parser, trailing, token, &options_ended);
+}
+
+/* Sets APE_UNKNOWN_ARG with the closest registered name as hint; false when none is close. */
+static bool report_unknown_option(ArgParser* parser, const char* text) {
+    const ArgNameIndex* index = argparse_hash_name_index(parser);
+    const ArgNameEntry* near = index ? argparse_name_index_suggest_internal(index, text) : NULL;
+
+    if (!near) return false;
+
+    char hint[160];
+    snprintf(hint, sizeof(hint), "did you mean '%s'?", near->name);
+
+    APE_SET_UNKNOWN(text);
+    argparse_error_set_hint(hint);
+    return true;
+}
+
+static ArgSubcommand* find_subcommand(const ArgParser* parser, const char* name) {
+    for (ArgSubcommand* sub = parser->subcommands; sub; sub = sub->next) {
+        if (strcmp(sub->name, name) == 0)
+            return sub;
+    }
+
+    return NULL;
+}
+
+/* Argument at a dense index, walking on from an earlier one when not parsing into a view. */
+static Argument* argument_at(const ArgParser* parser, Argument* from, size_t index) {
+    if (parser->overlay) return &parser->overlay[index];
+
+    Argument* arg = from && from->index <= index ? from : parser->arguments;
+    while (arg && arg->index != index) arg = arg->next;
+    return arg;
+}
+
+static const char* argument_name(const Argument* arg) {
+    return arg->short_name ? arg->short_name : arg->long_name ? arg->long_name : "(unnamed)";
+}
+
+/* Reports a rule violation of one argument, the other one involved as hint. */
+static void report_rule(ArgParser* parser, ArgParseErrorCategory category, size_t index,
+    const char* message, const char* relation, size_t other) {
+    char hint[160];
+    snprintf(hint, sizeof(hint), "%s '%s'", relation,
+        argument_name(argument_at(parser, NULL, other)));
+
+    APE_SET(category, EINVAL, argument_name(argument_at(parser, NULL, index)), message);
+    argparse_error_set_hint(hint);
+}
+
+/*
+ * Required arguments, exclusive groups and dependencies are whole-bitset operations on the
+ * set bits; only resolving fallback sources visits arguments one by one.
+ */
+static void validate_arguments(ArgParser* parser) {
+    const ArgBits* set = parser->set_bits;
+    size_t words = parser->bit_words;
+
+    /* values read without a getter take their fallback now, errors are the parse's */
+    if (parser->sources) {
+        Argument* cursor = NULL;
+
+        for (size_t i = argparse_bits_next_missing_internal(parser->eager_bits, set, words, 0);
+            i != ARGPARSE_BIT_NONE;
+            i = argparse_bits_next_missing_internal(parser->eager_bits, set, words, i + 1)) {
+            if (!(cursor = argument_at(parser, cursor, i))) break;
+
+            is_value_set(cursor);
+            if (argparse_error_occurred()) return;
+        }
+    }
+
+    size_t missing = argparse_bits_next_missing_internal(parser->required_bits, set, words, 0);
+
+    if (missing != ARGPARSE_BIT_NONE) {
+        APE_SET_REQUIRED(argument_name(argument_at(parser, NULL, missing)));
+        return;
+    }
+
+    for (const ArgGroup* group = parser->groups; group; group = group->next) {
+        size_t given = argparse_bits_count_common_internal(group->members, set, group->words);
+
+        if (given > 1) {
+            size_t first = argparse_bits_first_common_internal(group->members, set, group->words, 0);
+            size_t second = argparse_bits_first_common_internal(group->members, set,
+                group->words, first + 1);
+
+            report_rule(parser, APE_VALIDATION, second,
+                "Argument cannot be combined with another one of its group.",
+                "conflicts with", first);
+            return;
+        }
+
+        if (given == 0 && group->required) {
+            size_t first = argparse_bits_first_common_internal(group->members, group->members,
+                group->words, 0);
+
+            APE_SET(APE_REQUIRED, EINVAL, argument_name(argument_at(parser, NULL, first)),
+                "One argument of this group is required.");
+            return;
+        }
+    }
+
+    for (const ArgDependency* dep = parser->dependencies; dep; dep = dep->next) {
+        if (!ARGPARSE_BIT_TEST(set, dep->index)) continue;
+
+        size_t needed = argparse_bits_next_missing_internal(dep->needs, set, dep->words, 0);
+
+        if (needed != ARGPARSE_BIT_NONE) {
+            report_rule(parser, APE_REQUIRED, needed, "Required argument not provided.",
+                "needed by", dep->index);
+            return;
+        }
+    }
+}
+
+/*
+ * Apply classified tokens to their arguments, then validate required ones. A value naming
+ * a subcommand stops the walk; its token index is stored in dispatch (-1 otherwise).
+ */
+static void process_tokens(ArgParser* parser, const ArgToken* tokens, int count, int* dispatch) {
+    bool options_ended = false;
+
+    *dispatch = -1;
+    parser->active_subcommand = NULL;
+
+    ARGPARSE_STATS_START(convert_start);
+
+    for (int i = 0; i < count; i++) {
+        const ArgToken* token = &tokens[i];
+
+        switch (token->kind) {
+        case TOKEN_TERMINATOR:
+            options_ended = true;
+            continue;
+
+        case TOKEN_OPTION_VALUE: {
             /* process GNU-style argument */
+            Argument* gnu_arg = token->arg;
+            const char* gnu_value = token->value;
+
             if (gnu_arg->type == ARG_BOOL) {
-                parse_single_value(gnu_arg, gnu_value[0] ? gnu_value : "true");
+                parse_single_value(parser, gnu_arg, gnu_value[0] ? gnu_value : "true");
                 APE_RETURN_IF_ERROR(parser);
             }
             else if (gnu_arg->is_list) {
-                parse_list_with_delimiter(gnu_arg, gnu_value);
+                parse_list_with_delimiter(parser, gnu_arg, gnu_value);
                 APE_RETURN_IF_ERROR(parser);
             }
             else {
-                parse_single_value(gnu_arg, gnu_value);
+                parse_single_value(parser, gnu_arg, gnu_value);
                 APE_RETURN_IF_ERROR(parser);
             }
             continue;
         }
 
-        /* handle special help argument */
-        if (is_help_argument(current_arg)) {
+        case TOKEN_HELP:
+            /* handle special help argument */
             parser->help_requested = true;
-            argparse_print_help(parser);
+            if (!parser->overlay && !parser->batch) argparse_print_help(parser);
             APE_SET(APE_HELP_REQUESTED, 0, NULL, "Help requested by user.");
             APE_RETURN_IF_ERROR(parser);
             return;
-        }
 
-        /* single efficient lookup */
-        Argument* arg = argparse_hash_find_argument(parser, current_arg);
+        case TOKEN_OPTION: {
+            /* found argument, process based on type */
+            Argument* arg = token->arg;
 
-        if (arg) {
-            /* Found argument, process based on type */
             if (arg->type == ARG_BOOL) {
-                parse_single_value(arg, "");
+                parse_single_value(parser, arg, "");
                 APE_RETURN_IF_ERROR(parser);
             }
             else if (arg->is_list) {
-                i = parse_list_values(parser, arg, i, argc, argv);
+                i = parse_list_values(parser, arg, i, tokens, count);
                 APE_RETURN_IF_ERROR(parser);
             }
-            else if (i + 1 < argc) {
+            else if (i + 1 < count) {
+                /* "--" right after the option introduces a literal value */
+                if (tokens[i + 1].kind == TOKEN_TERMINATOR && i + 2 < count)
+                    i++;
+
                 /* check if next token is not a registered argument */
-                if (!argparse_hash_is_argument(parser, argv[i + 1])) {
-                    parse_single_value(arg, argv[++i]);
+                if (token_is_value(&tokens[i + 1])) {
+                    parse_single_value(parser, arg, tokens[++i].text);
                     APE_RETURN_IF_ERROR(parser);
                 }
                 else {
@@ -1191,31 +1982,626 @@ void argparse_parse(ArgParser* parser, int argc, char** argv) {
                 APE_RETURN_IF_ERROR(parser);
                 return;
             }
+            continue;
         }
-        else {
+
+        case TOKEN_VALUE:
+        default:
+            /* the rest of the command line belongs to the subcommand */
+            if (parser->subcommands && !options_ended && token->kind == TOKEN_VALUE &&
+                (parser->active_subcommand = find_subcommand(parser, token->text))) {
+                *dispatch = i;
+                goto validate;
+            }
+
+            /* an option-like typo near a registered name gets a suggestion */
+            if (token->text[0] == '-' && report_unknown_option(parser, token->text)) {
+                APE_RETURN_IF_ERROR(parser);
+                return;
+            }
+
             /* not a registered argument */
-            APE_SET(APE_SYNTAX, EINVAL, current_arg,
+            APE_SET(APE_SYNTAX, EINVAL, token->text,
                 "Unexpected value (did you forget an option?).");
             APE_RETURN_IF_ERROR(parser);
             return;
         }
     }
 
-    /* validate required arguments */
-    Argument* current = parser->arguments;
-    while (current != NULL) {
-        if (current->required && !current->set) {
-            const char* arg_name = current->short_name ? current->short_name :
-                current->long_name ? current->long_name :
-                "(unnamed)";
+validate:
+    ARGPARSE_STATS_STOP(convert_start, ARGPARSE_PHASE_CONVERT);
+    ARGPARSE_STATS_START(validate_start);
+
+    validate_arguments(parser);
+    APE_RETURN_IF_ERROR(parser);
+
+    ARGPARSE_STATS_STOP(validate_start, ARGPARSE_PHASE_VALIDATE);
+}
+
+static void run_parse(ArgParser* parser, int argc, char** argv, const ArgWords* trailing);
+
+/* "prog name" in the usage line of a child, rebuilt only when the parent's name changes. */
+static bool set_subcommand_program_name(const ArgParser* parser, ArgParser* child,
+    const char* name) {
+    const char* program = parser->program_name ? parser->program_name : "";
+    size_t program_len = strlen(program), name_len = strlen(name);
+    size_t separator = program_len ? 1 : 0;
+    const char* current = child->program_name;
+
+    if (current && strlen(current) == program_len + separator + name_len &&
+        memcmp(current, program, program_len) == 0 &&
+        strcmp(current + program_len + separator, name) == 0)
+        return true;
+
+    char* combined = (char*)argparse_arena_malloc(child->arena,
+        program_len + separator + name_len + 1);
+
+    if (!combined) {
+        APE_SET_MEMORY(name);
+        return false;
+    }
+
+    memcpy(combined, program, program_len);
+    if (separator) combined[program_len] = ' ';
+    memcpy(combined + program_len + separator, name, name_len + 1);
+
+    argparse_arena_free(child->arena, child->program_name);
+    child->program_name = combined;
+    invalidate_help(child);
+    return true;
+}
+
+/*
+ * Builds the selected child on first use and lets it parse the tokens from its name on.
+ * argv is the matching slice of the caller's argv, or NULL to point at the token texts.
+ */
+static void run_subcommand(ArgParser* parser, char** argv, const ArgToken* tokens, int count) {
+    ArgSubcommand* sub = parser->active_subcommand;
+
+    if (parser->overlay) {
+        APE_SET(APE_CONFIG, EINVAL, sub->name,
+            "Subcommands cannot be parsed through argparse_parse_r.");
+        return;
+    }
+
+    if (!sub->parser && !(sub->parser = sub->builder(sub->user_data))) {
+        if (!argparse_error_occurred())
+            APE_SET(APE_CONFIG, EINVAL, sub->name, "Subcommand builder failed.");
+        return;
+    }
+
+    ArgParser* child = sub->parser;
+    if (!set_subcommand_program_name(parser, child, sub->name))
+        return;
+
+    /* words from files or a buffer only need a vector of pointers, the text is shared */
+    char** words = NULL;
+
+    if (!argv) {
+        if (!(words = (char**)malloc((size_t)count * sizeof(char*)))) {
+            APE_SET_MEMORY(sub->name);
+            return;
+        }
+
+        for (int i = 0; i < count; i++)
+            words[i] = (char*)tokens[i].text;
+        argv = words;
+    }
+
+    /* a batch keeps the child quiet and borrowing too */
+    bool child_batch = child->batch, child_borrow = child->borrow_strings;
+
+    if (parser->batch) {
+        child->batch = true;
+        child->borrow_strings = parser->borrow_strings;
+    }
+
+    argparse_error_clear();
+    run_parse(child, count, argv, NULL);
+
+    child->batch = child_batch;
+    child->borrow_strings = child_borrow;
+    free(words);
+}
+
+/*
+ * Loads the "@file" arguments of argv (up to a "--") into expanded[], indexed like argv.
+ * Returns the number of tokens the expanded command line holds, -1 on error.
+ */
+static long expand_response_files(int argc, char** argv, ArgWords** expanded) {
+    long count = 0;
+    bool options_ended = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!options_ended && strcmp(argv[i], "--") == 0)
+            options_ended = true;
+
+        if (options_ended || argv[i][0] != '@' || argv[i][1] == '\0') {
+            count++;
+            continue;
+        }
+
+        if (!(expanded[i] = argparse_words_load_internal(argv[i] + 1)))
+            return -1;
+
+        /* the token array is indexed by int */
+        if (expanded[i]->count > (size_t)INT_MAX - (size_t)count) {
+            APE_SET_RANGE(argv[i], "Response file has too many arguments.");
+            return -1;
+        }
+
+        count += (long)expanded[i]->count;
+    }
+
+    return count;
+}
+
+/*
+ * Tokenizes and applies argv followed by the trailing words (NULL if none);
+ * errors are left in the thread-local state.
+ */
+static void run_parse(ArgParser* parser, int argc, char** argv, const ArgWords* trailing) {
+    /* short command lines are classified without touching the heap */
+    ArgToken stack_tokens[ARGPARSE_TOKEN_STACK];
+    ArgToken* tokens = stack_tokens;
+    long count = argc - 1;
+
+    ArgWords** expanded = NULL;
+    ArgWords* loaded = NULL;
+
+    /* counters follow this parse on this thread, a subcommand counts into its own parser */
+    ArgParseStats* outer_stats = argparse_stats_enter_internal(parser);
+    ARGPARSE_STATS_ADD(parses, 1);
+
+    if ((parser->flags & ARGPARSE_RESPONSE_FILES) && argc > 1) {
+        for (int i = 1; i < argc && !expanded; i++) {
+            if (argv[i][0] == '@' &&
+                !(expanded = (ArgWords**)calloc((size_t)argc, sizeof(ArgWords*)))) {
+                APE_SET_MEMORY(NULL);
+                goto cleanup;
+            }
+        }
+
+        if (expanded) {
+            count = expand_response_files(argc, argv, expanded);
+
+            /* chain the blocks so they are released (or retained) together */
+            for (int i = argc - 1; i > 0; i--) {
+                if (expanded[i]) {
+                    expanded[i]->next = loaded;
+                    loaded = expanded[i];
+                }
+            }
+
+            if (count < 0)
+                goto cleanup;
+        }
+    }
+
+    if (trailing) {
+        if (trailing->count > (size_t)INT_MAX - (size_t)count) {
+            APE_SET_RANGE(NULL, "Too many arguments.");
+            goto cleanup;
+        }
+        count += (long)trailing->count;
+    }
+
+    /* result arenas are short-lived, a parser keeps its largest token buffer for the next parse */
+    if (count > ARGPARSE_TOKEN_STACK && parser->overlay) {
+        size_t alloc_size;
+
+        if (!safe_multiply_size_t((size_t)count, sizeof(ArgToken), &alloc_size) ||
+            !(tokens = (ArgToken*)argparse_arena_malloc(parser->arena, alloc_size))) {
+            if (!argparse_error_occurred())
+                APE_SET_MEMORY(NULL);
+            tokens = stack_tokens;
+            goto cleanup;
+        }
+    }
+    else if (count > ARGPARSE_TOKEN_STACK) {
+        size_t alloc_size;
+
+        if ((size_t)count > parser->token_capacity) {
+            void* grown = safe_multiply_size_t((size_t)count, sizeof(ArgToken), &alloc_size)
+                ? realloc(parser->token_buffer, alloc_size) : NULL;
+
+            if (!grown) {
+                if (!argparse_error_occurred())
+                    APE_SET_MEMORY(NULL);
+                goto cleanup;
+            }
+
+            parser->token_buffer = grown;
+            parser->token_capacity = (size_t)count;
+        }
+
+        tokens = (ArgToken*)parser->token_buffer;
+    }
+
+    /* argv outlives the parser by contract, so values may point straight into it */
+    bool borrow = parser->borrow_strings;
+    if (parser->flags & ARGPARSE_BORROW_ARGV)
+        parser->borrow_strings = true;
+
+    /* one classification pass, then one processing pass */
+    tokenize_arguments(parser, argc, argv, expanded, trailing, tokens);
+
+    int dispatch = -1;
+
+    if (!argparse_error_occurred())
+        process_tokens(parser, tokens, (int)count, &dispatch);
+
+    /* argv lines up with the tokens unless response files or a buffer supplied words */
+    if (dispatch >= 0 && !argparse_error_occurred())
+        run_subcommand(parser, !expanded && !trailing ? argv + dispatch + 1 : NULL,
+            tokens + dispatch, (int)count - dispatch);
+
+    /* borrowed values may point into response files, keep those until argparse_free() */
+    if (loaded && (parser->borrow_strings || parser->active_subcommand)) {
+        ArgWords* last = loaded;
+        while (last->next) last = last->next;
+
+        last->next = parser->response_words;
+        parser->response_words = loaded;
+        loaded = NULL;
+    }
+
+    parser->borrow_strings = borrow;
+
+cleanup:
+    argparse_words_free_internal(loaded);
+    free(expanded);
+    argparse_stats_leave_internal(outer_stats);
+}
+
+/* Stores argv[0], it is part of the cached help text; unchanged names cost a strcmp. */
+static bool set_program_name(ArgParser* parser, const char* name) {
+    if (parser->program_name && strcmp(parser->program_name, name) == 0)
+        return true;
+
+    argparse_arena_free(parser->arena, parser->program_name);
+    invalidate_help(parser);
+
+    parser->program_name = argparse_arena_strdup(parser->arena, name);
+    if (!parser->program_name) {
+        APE_SET_MEMORY("program_name");
+        return false;
+    }
+
+    return true;
+}
+
+void argparse_parse(ArgParser* parser, int argc, char** argv) {
+    argparse_error_clear();
+
+    /* check for valid inputs */
+    if (!parser || !argv) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser or argv.");
+        APE_RETURN_IF_ERROR(parser);
+        return;
+    }
+
+    parser->completion_requested = false;
+
+    if (!set_program_name(parser, argv[0])) {
+        APE_RETURN_IF_ERROR(parser);
+        return;
+    }
+
+    /* the shell asks for candidates: answer from the name index, nothing is parsed */
+    if ((parser->flags & ARGPARSE_COMPLETION) && argc > 1 &&
+        strcmp(argv[1], ARGPARSE_COMPLETE_COMMAND) == 0 && !find_subcommand(parser, argv[1])) {
+        argparse_complete(parser, argc - 2, argv + 2, stdout);
+        parser->completion_requested = true;
+        return;
+    }
+
+    /* check if no arguments were provided */
+    if (argc == 1) {
+        argparse_print_help(parser);
+        APE_SET(APE_HELP_REQUESTED, 0, NULL, "No arguments provided, showing help.");
+        APE_RETURN_IF_ERROR(parser);
+        return;
+    }
+
+    run_parse(parser, argc, argv, NULL);
+    APE_RETURN_IF_ERROR(parser);
+}
+
+void argparse_parse_buffer(ArgParser* parser, const char* buf, size_t len) {
+    argparse_error_clear();
+
+    /* check for valid inputs */
+    if (!parser || (!buf && len > 0)) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser or buffer.");
+        APE_RETURN_IF_ERROR(parser);
+        return;
+    }
+
+    /* the working copy stays alive, string values are slices of it */
+    ArgParseStats* outer_stats = argparse_stats_enter_internal(parser);
+    ArgArena* pool = retained_arena(parser);
+    ArgWords words;
+    memset(&words, 0, sizeof(words));
+
+    bool copied = pool && len != SIZE_MAX &&
+        (words.data = (char*)argparse_arena_malloc(pool, len + 1)) != NULL;
+
+    if (copied && len > 0) {
+        memcpy(words.data, buf, len);
+        ARGPARSE_STATS_ADD(bytes_copied, len);
+    }
+
+    argparse_stats_leave_internal(outer_stats);
+
+    if (!copied) {
+        APE_SET_MEMORY(NULL);
+        APE_RETURN_IF_ERROR(parser);
+        return;
+    }
+
+    if (!argparse_words_split_internal(words.data, len, &words.count)) {
+        APE_RETURN_IF_ERROR(parser);
+        return;
+    }
+
+    if (words.count == 0) {
+        argparse_print_help(parser);
+        APE_SET(APE_HELP_REQUESTED, 0, NULL, "No arguments provided, showing help.");
+        APE_RETURN_IF_ERROR(parser);
+        return;
+    }
+
+    /* argv[0] is the program name of the command line, if any was recorded */
+    char* argv[2] = { parser->program_name ? parser->program_name : (char*)"", NULL };
+
+    bool borrow = parser->borrow_strings;
+    parser->borrow_strings = true;
+
+    run_parse(parser, 1, argv, &words);
+
+    parser->borrow_strings = borrow;
+    APE_RETURN_IF_ERROR(parser);
+}
+
+/* Puts one argument back in its registration state; list capacity is kept. */
+static void reset_argument(ArgParser* parser, Argument* arg) {
+    switch (arg->type) {
+    case ARG_INT: *(int*)arg->value = arg->initial.as_int; break;
+    case ARG_DOUBLE: *(double*)arg->value = arg->initial.as_double; break;
+    case ARG_BOOL: *(bool*)arg->value = arg->initial.as_bool; break;
+
+    case ARG_STRING:
+        if (arg->value && !arg->borrowed && arg->value != string_default(arg))
+            argparse_arena_free(parser->arena, arg->value);
+
+        arg->value = string_default(arg);
+        arg->borrowed = false;
+
+        if (arg->target)
+            *(char**)arg->target = arg->initial.as_string;
+        break;
+
+    default:
+        list_clear(parser, arg);
+        break;
+    }
+
+    arg->set = false;
+    arg->resolved = false;
+}
+
+void argparse_reset(ArgParser* parser) {
+    argparse_error_clear();
+    if (!parser) return;
+
+    for (Argument* arg = parser->arguments; arg; arg = arg->next)
+        reset_argument(parser, arg);
+
+    if (parser->set_bits)
+        memset(parser->set_bits, 0, parser->bit_words * sizeof(ArgBits));
+
+    /* children may borrow from the memory released below, they forget their values too */
+    for (ArgSubcommand* sub = parser->subcommands; sub; sub = sub->next) {
+        if (sub->parser)
+            argparse_reset(sub->parser);
+    }
+
+    parser->help_requested = false;
+    parser->completion_requested = false;
+    parser->active_subcommand = NULL;
+
+    /* nothing points into retained input any more, the pool keeps its blocks */
+    argparse_words_free_internal(parser->response_words);
+    parser->response_words = NULL;
+    argparse_arena_reset_internal(parser->string_pool);
+}
+
+size_t argparse_parse_batch(ArgParser* parser, size_t count, const int* argcs, char** const* argvs,
+    ArgBatchCallback callback, void* user_data) {
+    argparse_error_clear();
+
+    if (!parser || (count > 0 && (!argcs || !argvs || !callback))) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser, vectors or callback.");
+        return 0;
+    }
+
+    /* values borrow from the vectors, errors are the callback's to handle */
+    bool borrow = parser->borrow_strings, batch = parser->batch;
+    parser->borrow_strings = true;
+    parser->batch = true;
+
+    size_t done = 0;
+
+    while (done < count) {
+        int argc = argcs[done];
+        char** argv = argvs[done];
+
+        argparse_reset(parser);
+
+        if (!argv || argc < 1)
+            APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid argv.");
+        else if (set_program_name(parser, argv[0]))
+            run_parse(parser, argc, argv, NULL);
+
+        ArgParseErrorCategory error = argparse_error_occurred()
+            ? argparse_error_get_category() : APE_SUCCESS;
+
+        if (!callback(parser, done++, error, user_data))
+            break;
+    }
+
+    parser->borrow_strings = borrow;
+    parser->batch = batch;
+    return done;
+}
+
+/* Per-result copy of one schema argument; values start from the schema defaults. */
+static void init_result_argument(Argument* copy, const Argument* source) {
+    *copy = *source;
+    copy->next = NULL;
+    copy->target = NULL;
+    copy->set = false;
+    copy->list_count = 0;
+    copy->list_capacity = 0;
+
+    /* registration defaults, whatever the schema itself parsed since */
+    copy->scalar = source->initial;
+
+    switch (source->type) {
+    case ARG_INT: copy->value = &copy->scalar.as_int; break;
+    case ARG_DOUBLE: copy->value = &copy->scalar.as_double; break;
+    case ARG_BOOL: copy->value = &copy->scalar.as_bool; break;
+    default:
+        /* strings borrow the schema default, lists grow in the result arena */
+        copy->value = source->is_list ? NULL : string_default(source);
+        copy->initial.as_string = (char*)copy->value;
+        break;
+    }
+}
+
+ArgParseResult* argparse_parse_r(const ArgParser* parser, int argc, char** argv) {
+    argparse_error_clear();
+
+    if (!parser || !argv || argc < 1) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser or argv.");
+        return NULL;
+    }
+
+    /* everything owned by the result lives in one arena */
+    ArgArena* arena = argparse_arena_create_internal(0);
+    if (!arena) return NULL;
+
+    ArgParseResult* result = (ArgParseResult*)argparse_arena_calloc(arena, 1, sizeof(ArgParseResult));
+    size_t total = 0;
+
+    for (const Argument* arg = parser->arguments; arg; arg = arg->next)
+        total = arg->index + 1;
+
+    Argument* copies = result
+        ? (Argument*)argparse_arena_calloc(arena, total ? total : 1, sizeof(Argument)) : NULL;
+
+    if (!copies) {
+        argparse_arena_destroy_internal(arena);
+        APE_SET_MEMORY(NULL);
+        return NULL;
+    }
+
+    /* the view shares names, hash table and spec index with the schema, read-only */
+    ArgParser* view = &result->view;
+    *view = *parser;
+    view->arena = arena;
+    view->overlay = copies;
+    view->arguments = NULL;
+    view->program_name = NULL;
+    view->help_text = NULL;
+    view->help_length = 0;
+    view->help_requested = false;
+    view->owned_spec_index = NULL;
+    view->nodes = NULL;
+    view->names = NULL;
+    view->string_pool = NULL;
+    view->response_words = NULL;
+    view->stats = NULL;
+
+    /* the set bits are per parse, the required, eager and rule masks are the schema's */
+    view->set_bits = (ArgBits*)argparse_arena_calloc(arena,
+        parser->bit_words ? parser->bit_words : 1, sizeof(ArgBits));
+
+    if (!view->set_bits) {
+        argparse_arena_destroy_internal(arena);
+        APE_SET_MEMORY(NULL);
+        return NULL;
+    }
+
+    Argument* prev = NULL;
+
+    for (const Argument* arg = parser->arguments; arg; arg = arg->next) {
+        Argument* copy = &copies[arg->index];
+
+        init_result_argument(copy, arg);
+
+        /* fallbacks resolve into the copy, the schema sources are only read */
+        copy->owner = view;
+        copy->resolved = false;
+
+        if (prev) prev->next = copy;
+        else view->arguments = copy;
+        prev = copy;
+    }
+
+    view->tail = prev;
+
+    run_parse(view, argc, argv, NULL);
+
+    /* move the outcome into the result, the thread-local state is left as is */
+    result->error = argparse_error_occurred()
+        ? argparse_error_get_category() : APE_SUCCESS;
+    result->error_errno = argparse_error_occurred() ? argparse_error_get_errno() : 0;
+    result->help_requested = view->help_requested;
+
+    if (result->error != APE_SUCCESS)
+        snprintf(result->error_message, sizeof(result->error_message), "%s",
+            argparse_error_get_message());
 
-            APE_SET(APE_REQUIRED, EINVAL, arg_name,
-                "Required argument not provided.");
-            APE_RETURN_IF_ERROR(parser);
-            return;
-        }
-        current = current->next;
+    return result;
+}
+
+void argparse_result_free(ArgParseResult* result) {
+    if (!result) return;
+
+    argparse_words_free_internal(result->view.response_words);
+
+    /* the result itself is the first allocation in its arena */
+    argparse_arena_destroy_internal(result->view.arena);
+}
+
+ArgHandle argparse_result_get_handle(ArgParseResult* result, const char* name) {
+    /* clear any existing errors */
+    argparse_error_clear();
+
+    if (!result) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Result is NULL.");
+        return NULL;
     }
+
+    return resolve_argument(&result->view, argparse_hash_find_argument(&result->view, name));
+}
+
+ArgHandle argparse_result_handle(const ArgParseResult* result, ArgHandle handle) {
+    return result && handle ? resolve_argument(&result->view, handle) : NULL;
+}
+
+ArgParseErrorCategory argparse_result_error(const ArgParseResult* result) {
+    return result ? result->error : APE_INTERNAL;
+}
+
+const char* argparse_result_error_message(const ArgParseResult* result) {
+    return result ? result->error_message : "";
+}
+
+bool argparse_result_help_requested(const ArgParseResult* result) {
+    return result && result->help_requested;
 }
 
 bool argparse_get_bool(ArgParser* parser, const char* name) {
@@ -1228,7 +2614,7 @@ bool argparse_get_bool(ArgParser* parser, const char* name) {
     }
 
     Argument* arg = argparse_hash_find_argument(parser, name);
-    return arg && arg->set ? *(bool*)arg->value : false;
+    return arg && is_value_set(arg) ? *(bool*)arg->value : false;
 }
 
 int argparse_get_int(ArgParser* parser, const char* name) {
@@ -1241,7 +2627,7 @@ int argparse_get_int(ArgParser* parser, const char* name) {
     }
 
     Argument* arg = argparse_hash_find_argument(parser, name);
-    return arg && arg->set ? *(int*)arg->value : 0;
+    return arg && is_value_set(arg) ? *(int*)arg->value : 0;
 }
 
 double argparse_get_double(ArgParser* parser, const char* name) {
@@ -1254,7 +2640,7 @@ double argparse_get_double(ArgParser* parser, const char* name) {
     }
 
     Argument* arg = argparse_hash_find_argument(parser, name);
-    return arg && arg->set ? *(double*)arg->value : 0.0;
+    return arg && is_value_set(arg) ? *(double*)arg->value : 0.0;
 }
 
 const char* argparse_get_string(ArgParser* parser, const char* name) {
@@ -1267,7 +2653,130 @@ const char* argparse_get_string(ArgParser* parser, const char* name) {
     }
 
     Argument* arg = argparse_hash_find_argument(parser, name);
-    return arg && arg->set ? (const char*)arg->value : NULL;
+    return arg && is_value_set(arg) ? (const char*)arg->value : NULL;
+}
+
+ArgHandle argparse_get_handle(ArgParser* parser, const char* name) {
+    /* clear any existing errors */
+    argparse_error_clear();
+
+    if (!parser) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
+        return NULL;
+    }
+
+    return argparse_hash_find_argument(parser, name);
+}
+
+bool argparse_add_subcommand(ArgParser* parser, const char* name, const char* help,
+    ArgSubcommandBuilder builder, void* user_data) {
+    argparse_error_clear();
+
+    if (!parser || !name || name[0] == '\0' || !builder) {
+        APE_SET(APE_INTERNAL, EINVAL, name, "Invalid parser, subcommand name or builder.");
+        return false;
+    }
+
+    if (find_subcommand(parser, name)) {
+        APE_SET(APE_CONFIG, EINVAL, name, "Duplicate subcommand.");
+        return false;
+    }
+
+    /* only the entry is created here, the child parser waits for its first dispatch */
+    ArgArena* arena = parser->arena;
+    ArgSubcommand* sub = (ArgSubcommand*)argparse_arena_calloc(arena, 1, sizeof(ArgSubcommand));
+
+    if (!sub || !(sub->name = argparse_arena_strdup(arena, name)) ||
+        (help && !(sub->help = argparse_arena_strdup(arena, help)))) {
+        if (sub) {
+            argparse_arena_free(arena, sub->name);
+            argparse_arena_free(arena, sub);
+        }
+        APE_SET_MEMORY(name);
+        return false;
+    }
+
+    sub->builder = builder;
+    sub->user_data = user_data;
+
+    if (parser->subcommands_tail) parser->subcommands_tail->next = sub;
+    else parser->subcommands = sub;
+    parser->subcommands_tail = sub;
+
+    invalidate_help(parser);
+    return true;
+}
+
+ArgParser* argparse_get_subcommand(ArgParser* parser, const char** name) {
+    /* clear any existing errors */
+    argparse_error_clear();
+
+    if (!parser) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
+        if (name) *name = NULL;
+        return NULL;
+    }
+
+    ArgSubcommand* sub = parser->active_subcommand;
+    if (name) *name = sub ? sub->name : NULL;
+    return sub ? sub->parser : NULL;
+}
+
+/* Handle getters are plain loads: no lookup and no error-state reset (bar a first fallback read). */
+bool argparse_handle_get_bool(ArgHandle handle) {
+    return handle && is_value_set(handle) && handle->type == ARG_BOOL ? *(bool*)handle->value : false;
+}
+
+int argparse_handle_get_int(ArgHandle handle) {
+    return handle && is_value_set(handle) && handle->type == ARG_INT ? *(int*)handle->value : 0;
+}
+
+double argparse_handle_get_double(ArgHandle handle) {
+    return handle && is_value_set(handle) && handle->type == ARG_DOUBLE ? *(double*)handle->value : 0.0;
+}
+
+const char* argparse_handle_get_string(ArgHandle handle) {
+    return handle && is_value_set(handle) && handle->type == ARG_STRING ? (const char*)handle->value : NULL;
+}
+
+bool argparse_handle_is_set(ArgHandle handle) {
+    return handle && is_value_set(handle);
+}
+
+int argparse_handle_get_list_count(ArgHandle handle) {
+    return handle && is_value_set(handle) && handle->is_list ? (int)handle->list_count : 0;
+}
+
+/* Borrowed list storage behind a handle, NULL unless set with the given type. */
+static const void* handle_list_view(ArgHandle handle, ArgType type, int* count) {
+    if (!handle || !is_value_set(handle) || handle->type != type || handle->list_count == 0) {
+        *count = 0;
+        return NULL;
+    }
+
+    *count = (int)handle->list_count;
+    return handle->value;
+}
+
+int argparse_handle_get_int_list_view(ArgHandle handle, const int** values) {
+    int count = 0;
+    const void* view = handle_list_view(handle, ARG_INT_LIST, &count);
+    if (values) *values = (const int*)view;
+    return count;
+}
+
+int argparse_handle_get_double_list_view(ArgHandle handle, const double** values) {
+    int count = 0;
+    const void* view = handle_list_view(handle, ARG_DOUBLE_LIST, &count);
+    if (values) *values = (const double*)view;
+    return count;
+}
+
+int argparse_handle_get_string_list_view(ArgHandle handle, const char* const** values) {
+    int count = 0;
+    const void* view = handle_list_view(handle, ARG_STRING_LIST, &count);
+    if (values) *values = (const char* const*)view;
+    return count;
 }
 
 int argparse_get_list_count(ArgParser* parser, const char* name) {
@@ -1280,10 +2789,9 @@ int argparse_get_list_count(ArgParser* parser, const char* name) {
     }
 
     Argument* arg = argparse_hash_find_argument(parser, name);
-    if (!arg || !arg->set) return 0;
+    if (!arg || !is_value_set(arg) || !arg->is_list) return 0;
 
-    ListNode* head = *(ListNode**)arg->value;
-    return list_length(head);
+    return (int)arg->list_count;
 }
 
 int argparse_get_int_list(ArgParser* parser, const char* name, int** values) {
@@ -1310,19 +2818,11 @@ int argparse_get_int_list(ArgParser* parser, const char* name, int** values) {
     /* find the argument */
     Argument* arg = argparse_hash_find_argument(parser, name);
 
-    if (!arg || !arg->set || arg->type != ARG_INT_LIST)
-        return 0;
-
-    /* get list head */
-    ListNode* head = *(ListNode**)arg->value;
-
-    if (!head) {
-        *values = NULL;
+    if (!arg || !is_value_set(arg) || arg->type != ARG_INT_LIST)
         return 0;
-    }
 
-    /* count elements and allocate memory */
-    int count = list_length(head);
+    /* element count is tracked alongside the buffer */
+    int count = (int)arg->list_count;
 
     if (count == 0) {
         *values = NULL;
@@ -1338,7 +2838,7 @@ int argparse_get_int_list(ArgParser* parser, const char* name, int** values) {
     }
 
     /* alloc memory for the array with overflow protection */
-    int* array = (int*)malloc((size_t)count * sizeof(int));
+    int* array = (int*)malloc(alloc_size);
 
     if (!array) {
         APE_SET_MEMORY(name);
@@ -1346,19 +2846,8 @@ int argparse_get_int_list(ArgParser* parser, const char* name, int** values) {
         return 0;
     }
 
-    /* copy data from linked list to contiguous array */
-    ListNode* current = head;
-    int i = 0;
-
-    while (current != NULL && i < count) {
-        if (current->data != NULL)
-            array[i] = *(int*)current->data;
-        else array[i] = 0;
-
-        current = current->next;
-        i++;
-    }
-
+    /* storage is already contiguous, copy it in one pass */
+    memcpy(array, arg->value, alloc_size);
     *values = array;
     return count;
 }
@@ -1387,12 +2876,11 @@ int argparse_get_double_list(ArgParser* parser, const char* name, double** value
     /* find the argument */
     Argument* arg = argparse_hash_find_argument(parser, name);
 
-    if (!arg || !arg->set || arg->type != ARG_DOUBLE_LIST)
+    if (!arg || !is_value_set(arg) || arg->type != ARG_DOUBLE_LIST)
         return 0;
 
-    /* get list head and count */
-    ListNode* head = *(ListNode**)arg->value;
-    int count = list_length(head);
+    /* element count is tracked alongside the buffer */
+    int count = (int)arg->list_count;
 
     if (count == 0) {
         *values = NULL;
@@ -1408,7 +2896,7 @@ int argparse_get_double_list(ArgParser* parser, const char* name, double** value
     }
 
     /* alloc memory for the array */
-    double* array = (double*)malloc((size_t)count * sizeof(double));
+    double* array = (double*)malloc(alloc_size);
 
     if (array == NULL) {
         APE_SET_MEMORY(name);
@@ -1416,16 +2904,8 @@ int argparse_get_double_list(ArgParser* parser, const char* name, double** value
         return 0;
     }
 
-    /* copy data from linked list to array */
-    ListNode* current = head;
-
-    for (int i = 0; i < count && current; i++) {
-        if (current->data)
-            array[i] = *(double*)current->data;
-        else array[i] = 0.0;
-        current = current->next;
-    }
-
+    /* storage is already contiguous, copy it in one pass */
+    memcpy(array, arg->value, alloc_size);
     *values = array;
     return count;
 }
@@ -1454,12 +2934,11 @@ int argparse_get_string_list(ArgParser* parser, const char* name, char*** values
     /* find the argument */
     Argument* arg = argparse_hash_find_argument(parser, name);
 
-    if (!arg || !arg->set || arg->type != ARG_STRING_LIST)
+    if (!arg || !is_value_set(arg) || arg->type != ARG_STRING_LIST)
         return 0;
 
-    /* get list head and count */
-    ListNode* head = *(ListNode**)arg->value;
-    int count = list_length(head);
+    /* element count is tracked alongside the buffer */
+    int count = (int)arg->list_count;
 
     if (count == 0) {
         *values = NULL;
@@ -1475,7 +2954,7 @@ int argparse_get_string_list(ArgParser* parser, const char* name, char*** values
     }
 
     /* alloc array for string pointers */
-    char** string_array = (char**)malloc((size_t)count * sizeof(char*));
+    char** string_array = (char**)malloc(alloc_size);
 
     if (!string_array) {
         APE_SET_MEMORY(name);
@@ -1484,14 +2963,13 @@ int argparse_get_string_list(ArgParser* parser, const char* name, char*** values
     }
 
     /* duplicate all strings from the list */
-    ListNode* current = head;
-    int i = 0;
+    char** source = (char**)arg->value;
 
-    while (current && i < count) {
-        char* source_str = (char*)current->data;
+    for (int i = 0; i < count; i++) {
+        char* source_str = source[i];
 
         if (source_str) {
-            string_array[i] = strdup(source_str);
+            string_array[i] = argparse_strdup(source_str);
 
             if (!string_array[i]) {
                 /* clean up on failure and return */
@@ -1508,15 +2986,78 @@ int argparse_get_string_list(ArgParser* parser, const char* name, char*** values
         else
             /* handle NULL strings in the list */
             string_array[i] = NULL;
-
-        current = current->next;
-        i++;
     }
 
     *values = string_array;
     return count;
 }
 
+/* Shared validation for the borrowing list accessors. */
+static const Argument* find_list_view(ArgParser* parser, const char* name,
+    ArgType type, const void* values) {
+    /* clear any existing errors */
+    argparse_error_clear();
+
+    if (!parser) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
+        return NULL;
+    }
+
+    if (!name || name[0] == '\0') {
+        APE_SET(APE_INTERNAL, EINVAL, NULL,
+            "Argument name are empty or NULL.");
+        return NULL;
+    }
+
+    if (!values) {
+        APE_SET(APE_INTERNAL, EINVAL, name, "Output pointer is NULL.");
+        return NULL;
+    }
+
+    Argument* arg = argparse_hash_find_argument(parser, name);
+
+    if (!arg || !is_value_set(arg) || arg->type != type || arg->list_count == 0)
+        return NULL;
+
+    return arg;
+}
+
+int argparse_get_int_list_view(ArgParser* parser, const char* name, const int** values) {
+    const Argument* arg = find_list_view(parser, name, ARG_INT_LIST, values);
+
+    if (!arg) {
+        if (values) *values = NULL;
+        return 0;
+    }
+
+    *values = (const int*)arg->value;
+    return (int)arg->list_count;
+}
+
+int argparse_get_double_list_view(ArgParser* parser, const char* name, const double** values) {
+    const Argument* arg = find_list_view(parser, name, ARG_DOUBLE_LIST, values);
+
+    if (!arg) {
+        if (values) *values = NULL;
+        return 0;
+    }
+
+    *values = (const double*)arg->value;
+    return (int)arg->list_count;
+}
+
+int argparse_get_string_list_view(ArgParser* parser, const char* name, const char* const** values) {
+    const Argument* arg = find_list_view(parser, name, ARG_STRING_LIST, values);
+
+    if (!arg) {
+        if (values) *values = NULL;
+        return 0;
+    }
+
+    *values = (const char* const*)arg->value;
+    return (int)arg->list_count;
+}
+
 void argparse_free_int_list(int** values) {
     if (!values || !*values) return;
     free(*values);
@@ -1539,68 +3080,218 @@ void argparse_free_string_list(char*** values, int count) {
     *values = NULL;
 }
 
-void argparse_print_help(ArgParser* parser) {
-    /* clean up error system */
-    argparse_error_clear();
+/* Help layout: indented names, help text on a shared column that long names wrap below. */
+#define HELP_INDENT 2
+#define HELP_GAP 2
+#define HELP_MAX_COLUMN 32
+
+/* Growable help buffer, allocated from the parser arena when there is one. */
+typedef struct HelpBuffer {
+    ArgArena* arena;
+    char* data;
+    size_t length;
+    size_t capacity;
+} HelpBuffer;
+
+static bool help_append(HelpBuffer* help, const char* text, size_t length) {
+    if (help->capacity - help->length < length + 1) {
+        size_t capacity = help->capacity ? help->capacity : 1024;
+
+        while (capacity - help->length < length + 1) {
+            if (capacity > SIZE_MAX / 2) return false;
+            capacity *= 2;
+        }
 
-    if (!parser) {
-        APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
-        return;
+        char* data = (char*)argparse_arena_realloc(help->arena, help->data,
+            help->capacity, capacity);
+        if (!data) return false;
+
+        help->data = data;
+        help->capacity = capacity;
     }
 
-    /* print usage header */
-    fputs("Usage: ", stdout);
-    fputs(parser->program_name ? parser->program_name : "", stdout);
-    fputs(" [OPTIONS]\n\n", stdout);
+    memcpy(help->data + help->length, text, length);
+    help->length += length;
+    help->data[help->length] = '\0';
+    return true;
+}
+
+static bool help_puts(HelpBuffer* help, const char* text) {
+    return help_append(help, text, strlen(text));
+}
+
+static bool help_pad(HelpBuffer* help, size_t count) {
+    static const char spaces[] = "                                ";
+
+    while (count > 0) {
+        size_t chunk = count < sizeof(spaces) - 1 ? count : sizeof(spaces) - 1;
+        if (!help_append(help, spaces, chunk)) return false;
+        count -= chunk;
+    }
+
+    return true;
+}
+
+static const char* help_placeholder(ArgType type) {
+    switch (type) {
+    case ARG_INT:
+    case ARG_DOUBLE:
+    case ARG_STRING:
+        return " VALUE";
+    case ARG_INT_LIST:
+    case ARG_DOUBLE_LIST:
+    case ARG_STRING_LIST:
+        return " VALUE1 VALUE2 ...";
+    default:
+        return "";
+    }
+}
+
+/* Width of "  -s, --long VALUE" for one argument. */
+static size_t help_names_width(const Argument* arg) {
+    size_t width = HELP_INDENT + strlen(help_placeholder(arg->type));
+
+    if (arg->short_name) width += strlen(arg->short_name);
+    if (arg->long_name) width += strlen(arg->long_name);
+    if (arg->short_name && arg->long_name) width += 2;
+
+    return width;
+}
 
-    /* print description if available */
-    if (parser->description && parser->description[0] != '\0') {
-        fputs(parser->description, stdout);
-        fputs("\n\n", stdout);
+/* Renders the complete help text once; later calls reuse it until it is invalidated. */
+static const char* help_text(ArgParser* parser, size_t* length) {
+    if (parser->help_text) {
+        *length = parser->help_length;
+        return parser->help_text;
     }
 
-    /* iterate through arguments */
-    Argument* arg = parser->arguments;
+    /* the help column follows the widest names, long ones wrap below it */
+    size_t column = 0;
 
-    while (arg) {
-        /* argument names */
-        printf("  ");
+    for (const Argument* arg = parser->arguments; arg; arg = arg->next) {
+        size_t width = help_names_width(arg);
+        if (width > column) column = width;
+    }
 
-        if (arg->short_name)
-            printf("%s", arg->short_name);
+    for (const ArgSubcommand* sub = parser->subcommands; sub; sub = sub->next) {
+        size_t width = HELP_INDENT + strlen(sub->name);
+        if (width > column) column = width;
+    }
+
+    column += HELP_GAP;
+    if (column > HELP_MAX_COLUMN) column = HELP_MAX_COLUMN;
+
+    HelpBuffer help = { parser->arena, NULL, 0, 0 };
+
+    /* usage header */
+    bool ok = help_puts(&help, "Usage: ") &&
+        help_puts(&help, parser->program_name ? parser->program_name : "") &&
+        help_puts(&help, parser->subcommands ? " [OPTIONS] COMMAND [ARGS]\n\n" : " [OPTIONS]\n\n");
+
+    /* description if available */
+    if (ok && parser->description && parser->description[0] != '\0')
+        ok = help_puts(&help, parser->description) && help_puts(&help, "\n\n");
+
+    for (const Argument* arg = parser->arguments; arg && ok; arg = arg->next) {
+        const char* text = arg->help ? arg->help : "";
+        size_t width = help_names_width(arg);
 
-        if (arg->long_name) {
-            if (arg->short_name)
-                printf(", ");
-            
-            printf("%s", arg->long_name);
+        ok = help_pad(&help, HELP_INDENT);
+
+        if (ok && arg->short_name)
+            ok = help_puts(&help, arg->short_name);
+
+        if (ok && arg->long_name)
+            ok = (!arg->short_name || help_puts(&help, ", ")) && help_puts(&help, arg->long_name);
+
+        if (ok)
+            ok = help_puts(&help, help_placeholder(arg->type));
+
+        /* help text and required flag, aligned on the help column */
+        if (ok && (text[0] != '\0' || arg->required)) {
+            if (width + HELP_GAP <= column)
+                ok = help_pad(&help, column - width);
+            else
+                ok = help_puts(&help, "\n") && help_pad(&help, column);
+
+            if (ok) ok = help_puts(&help, text);
+            if (ok && arg->required)
+                ok = help_puts(&help, text[0] != '\0' ? " [required]" : "[required]");
         }
 
-        /* Argument value placeholder */
-        switch (arg->type) {
-        case ARG_INT:
-        case ARG_DOUBLE:
-        case ARG_STRING:
-            printf(" VALUE");
-            break;
-        case ARG_INT_LIST:
-        case ARG_DOUBLE_LIST:
-        case ARG_STRING_LIST:
-            printf(" VALUE1 VALUE2 ...");
-            break;
-        default:
-            break;
+        if (ok) ok = help_puts(&help, "\n");
+    }
+
+    if (ok && parser->subcommands)
+        ok = help_puts(&help, "\nCommands:\n");
+
+    for (const ArgSubcommand* sub = parser->subcommands; sub && ok; sub = sub->next) {
+        size_t width = HELP_INDENT + strlen(sub->name);
+
+        ok = help_pad(&help, HELP_INDENT) && help_puts(&help, sub->name);
+
+        if (ok && sub->help && sub->help[0] != '\0') {
+            if (width + HELP_GAP <= column)
+                ok = help_pad(&help, column - width);
+            else
+                ok = help_puts(&help, "\n") && help_pad(&help, column);
+
+            if (ok) ok = help_puts(&help, sub->help);
         }
 
-        /* help text and required flag */
-        printf("\n    %s", arg->help != NULL ? arg->help : "");
+        if (ok) ok = help_puts(&help, "\n");
+    }
+
+    if (!ok || !help.data) {
+        argparse_arena_free(parser->arena, help.data);
+        APE_SET_MEMORY(NULL);
+        return NULL;
+    }
+
+    parser->help_text = help.data;
+    parser->help_length = help.length;
+
+    *length = help.length;
+    return help.data;
+}
+
+void argparse_print_help(ArgParser* parser) {
+    /* clean up error system */
+    argparse_error_clear();
+
+    if (!parser) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
+        return;
+    }
+
+    size_t length = 0;
+    const char* text = help_text(parser, &length);
 
-        if (arg->required)
-            printf(" [required]");
+    /* the whole text goes out in one write */
+    if (text)
+        fwrite(text, 1, length, stdout);
+}
+
+size_t argparse_format_help(ArgParser* parser, char* buf, size_t len) {
+    argparse_error_clear();
+
+    if (!parser || (!buf && len > 0)) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser or buffer.");
+        return 0;
+    }
 
-        printf("\n");
-        arg = arg->next;
+    size_t length = 0;
+    const char* text = help_text(parser, &length);
+    if (!text) return 0;
+
+    /* snprintf-like: truncate, always terminate, report the full length */
+    if (len > 0) {
+        size_t copied = length < len - 1 ? length : len - 1;
+        memcpy(buf, text, copied);
+        buf[copied] = '\0';
     }
+
+    return length;
 }
 
 int argparse_get_last_error(void) {
@@ -1621,19 +3312,67 @@ void argparse_free(ArgParser* parser) {
     /* clean up error system for this thread */
     argparse_error_clear();
 
+    argparse_words_free_internal(parser->response_words);
+
+    for (ArgSource* source = parser->sources; source; source = source->next)
+        argparse_words_free_internal(source->entries);
+
+    /* children are separate parsers, whatever memory their parent uses */
+    for (ArgSubcommand* sub = parser->subcommands; sub; sub = sub->next)
+        argparse_free(sub->parser);
+
+    free(parser->token_buffer);
+    argparse_arena_destroy_internal(parser->string_pool);
+
+    /* arena-backed parsers release everything, themselves included, in one shot */
+    if (parser->arena) {
+        argparse_arena_destroy_internal(parser->nodes);
+        argparse_intern_pool_destroy_internal(parser->names);
+        argparse_arena_destroy_internal(parser->arena);
+        return;
+    }
+
     if (parser->hash_table) {
         argparse_hash_destroy_internal(parser->hash_table);
         parser->hash_table = NULL;
     }
 
+    argparse_name_index_destroy_internal(parser->name_index);
+    argparse_rules_free_internal(parser);
+
     Argument* current = parser->arguments;
 
     while (current) {
         Argument* next = current->next;
-        free_argument(current);
+
+        /* names and nodes go with their pools, spec names are borrowed anyway */
+        free_argument_value(parser, current);
+
         current = next;
     }
 
+    argparse_arena_destroy_internal(parser->nodes);
+    argparse_intern_pool_destroy_internal(parser->names);
+
+    free(parser->spec_arguments);
+    argparse_spec_index_free(parser->owned_spec_index);
+
+    for (ArgSource* source = parser->sources, *next; source; source = next) {
+        next = source->next;
+        free((void*)source->keys);
+        free(source->prefix);
+        free(source);
+    }
+
+    for (ArgSubcommand* sub = parser->subcommands, *next; sub; sub = next) {
+        next = sub->next;
+        free(sub->name);
+        free(sub->help);
+        free(sub);
+    }
+
+    free(parser->stats);
+    free(parser->help_text);
     free(parser->program_name);
     free(parser->description);
     free(parser);
@@ -0,0 +1,228 @@
+#include "argparse_arena.h"
+#include "argparse_error.h"
+#include "argparse_stats.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Strictest fundamental alignment, computed portably for C99. */
+typedef union ArenaMaxAlign {
+    long double ld;
+    long long ll;
+    double d;
+    void* p;
+    void (*fp)(void);
+} ArenaMaxAlign;
+
+#define ARENA_ALIGNMENT offsetof(struct { char c; ArenaMaxAlign a; }, a)
+
+static size_t align_up(size_t value) {
+    return (value + (ARENA_ALIGNMENT - 1)) & ~(ARENA_ALIGNMENT - 1);
+}
+
+/* Offset of the first usable byte after the block header. */
+static size_t block_header_size(void) {
+    return align_up(sizeof(ArgArenaBlock));
+}
+
+static unsigned char* block_data(ArgArenaBlock* block) {
+    return (unsigned char*)block + block_header_size();
+}
+
+static ArgArenaBlock* arena_new_block(size_t capacity) {
+    size_t header = block_header_size();
+
+    /* overflow check for safety */
+    if (capacity > SIZE_MAX - header)
+        return NULL;
+
+    ArgArenaBlock* block = (ArgArenaBlock*)malloc(header + capacity);
+    if (!block) return NULL;
+
+    block->next = NULL;
+    block->capacity = capacity;
+    block->used = 0;
+    return block;
+}
+
+ArgArena* argparse_arena_create_internal(size_t block_size) {
+    if (block_size == 0)
+        block_size = ARGPARSE_ARENA_BLOCK_SIZE;
+
+    block_size = align_up(block_size);
+    ArgArenaBlock* block = arena_new_block(block_size);
+
+    if (!block) {
+        APE_SET_MEMORY(NULL);
+        return NULL;
+    }
+
+    /* the arena header lives at the start of its own first block */
+    ArgArena* arena = (ArgArena*)block_data(block);
+    block->used = align_up(sizeof(ArgArena));
+
+    arena->head = block;
+    arena->block_size = block_size;
+    arena->last_alloc = NULL;
+    arena->spare = NULL;
+    arena->first = block;
+    return arena;
+}
+
+void argparse_arena_destroy_internal(ArgArena* arena) {
+    if (!arena) return;
+
+    ArgArenaBlock* first = arena->first;
+
+    for (ArgArenaBlock* block = arena->spare, *next; block; block = next) {
+        next = block->next;
+        free(block);
+    }
+
+    /* oversized blocks sit anywhere in the chain, so skip the header block by identity */
+    for (ArgArenaBlock* block = arena->head, *next; block; block = next) {
+        next = block->next;
+        if (block != first) free(block);
+    }
+
+    /* the arena itself lives in this one */
+    free(first);
+}
+
+void argparse_arena_reset_internal(ArgArena* arena) {
+    if (!arena) return;
+    ArgArenaBlock* first = arena->first;
+
+    /* every block but the one holding the arena itself becomes spare, wherever it sits */
+    for (ArgArenaBlock* block = arena->head, *next; block; block = next) {
+        next = block->next;
+        if (block == first) continue;
+
+        block->used = 0;
+        block->next = arena->spare;
+        arena->spare = block;
+    }
+
+    first->next = NULL;
+    first->used = align_up(sizeof(ArgArena));
+    arena->head = first;
+    arena->last_alloc = NULL;
+}
+
+/* A spare block with room for size bytes, else a new one. */
+static ArgArenaBlock* arena_take_block(ArgArena* arena, size_t size, size_t capacity) {
+    for (ArgArenaBlock** link = &arena->spare; *link; link = &(*link)->next) {
+        ArgArenaBlock* block = *link;
+
+        if (block->capacity >= size) {
+            *link = block->next;
+            block->next = NULL;
+            return block;
+        }
+    }
+
+    return arena_new_block(capacity);
+}
+
+static void* arena_bump(ArgArena* arena, size_t size) {
+    if (size == 0) size = 1;
+    if (size > SIZE_MAX - ARENA_ALIGNMENT) return NULL;
+
+    size = align_up(size);
+    ArgArenaBlock* block = arena->head;
+
+    if (block->capacity - block->used < size) {
+        /* oversized requests get a dedicated block */
+        size_t capacity = size > arena->block_size
+            ? size : arena->block_size;
+        ArgArenaBlock* fresh = arena_take_block(arena, size, capacity);
+        if (!fresh) return NULL;
+
+        if (size > arena->block_size && block->capacity - block->used > 0) {
+            /* keep filling the current block, file the big one behind it */
+            fresh->next = block->next;
+            block->next = fresh;
+            fresh->used = size;
+            arena->last_alloc = NULL;
+            return block_data(fresh);
+        }
+
+        fresh->next = block;
+        arena->head = fresh;
+        block = fresh;
+    }
+
+    void* ptr = block_data(block) + block->used;
+    block->used += size;
+    arena->last_alloc = ptr;
+    return ptr;
+}
+
+void* argparse_arena_malloc(ArgArena* arena, size_t size) {
+    ARGPARSE_STATS_ADD(allocations, 1);
+
+    if (!arena) return malloc(size);
+    return arena_bump(arena, size);
+}
+
+void* argparse_arena_calloc(ArgArena* arena, size_t count, size_t size) {
+    ARGPARSE_STATS_ADD(allocations, 1);
+
+    if (!arena) return calloc(count, size);
+
+    /* overflow check for safety */
+    if (size != 0 && count > SIZE_MAX / size)
+        return NULL;
+
+    void* ptr = arena_bump(arena, count * size);
+    if (ptr) memset(ptr, 0, count * size);
+    return ptr;
+}
+
+void* argparse_arena_realloc(ArgArena* arena, void* ptr, size_t old_size, size_t new_size) {
+    ARGPARSE_STATS_ADD(allocations, 1);
+
+    if (!arena) return realloc(ptr, new_size);
+    if (!ptr) return arena_bump(arena, new_size);
+    if (new_size <= old_size) return ptr;
+
+    /* grow in place when this was the latest bump allocation */
+    ArgArenaBlock* block = arena->head;
+
+    if (ptr == arena->last_alloc && new_size <= SIZE_MAX - ARENA_ALIGNMENT) {
+        size_t offset = (size_t)((unsigned char*)ptr - block_data(block));
+        size_t end = offset + align_up(new_size);
+
+        if (end <= block->capacity) {
+            block->used = end;
+            return ptr;
+        }
+    }
+
+    void* fresh = arena_bump(arena, new_size);
+    if (!fresh) return NULL;
+
+    memcpy(fresh, ptr, old_size);
+    ARGPARSE_STATS_ADD(bytes_copied, old_size);
+    return fresh;
+}
+
+void argparse_arena_free(ArgArena* arena, void* ptr) {
+    /* arena memory is reclaimed in one shot by argparse_arena_destroy_internal */
+    if (!arena) free(ptr);
+}
+
+char* argparse_arena_strdup(ArgArena* arena, const char* str) {
+    if (!str) return NULL;
+    size_t len = strlen(str);
+
+    /* overflow check for safety */
+    if (len == SIZE_MAX) return NULL;
+
+    char* copy = (char*)argparse_arena_malloc(arena, len + 1);
+    if (!copy) return NULL;
+
+    memcpy(copy, str, len + 1);
+    ARGPARSE_STATS_ADD(bytes_copied, len + 1);
+    return copy;
+}
@@ -0,0 +1,231 @@
+#include "argparse.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Placeholders of the script templates: the command name and its shell identifier. */
+#define NAME "\001"
+#define IDENT "\002"
+
+static const char* const g_bash_script =
+    "# bash completion for " NAME ", generated by argparse\n"
+    "_" IDENT "_complete() {\n"
+    "    local line\n"
+    "    COMPREPLY=()\n"
+    "    while IFS= read -r line; do\n"
+    "        COMPREPLY+=(\"${line%%$'\\t'*}\")\n"
+    "    done < <(\"${COMP_WORDS[0]}\" " ARGPARSE_COMPLETE_COMMAND
+    " \"${COMP_WORDS[@]:1:COMP_CWORD}\" 2>/dev/null)\n"
+    "    [ ${#COMPREPLY[@]} -gt 0 ] || compopt -o default 2>/dev/null\n"
+    "    return 0\n"
+    "}\n"
+    "complete -F _" IDENT "_complete " NAME "\n";
+
+static const char* const g_zsh_script =
+    "#compdef " NAME "\n"
+    "# zsh completion for " NAME ", generated by argparse\n"
+    "_" IDENT "() {\n"
+    "    local line\n"
+    "    local -a candidates\n"
+    "    for line in \"${(@f)$(\"${words[1]}\" " ARGPARSE_COMPLETE_COMMAND
+    " \"${(@)words[2,CURRENT]}\" 2>/dev/null)}\"; do\n"
+    "        [[ -n $line ]] && candidates+=(\"${${line//:/\\\\:}/$'\\t'/:}\")\n"
+    "    done\n"
+    "    if (( ${#candidates} )); then\n"
+    "        _describe -t arguments argument candidates\n"
+    "    else\n"
+    "        _files\n"
+    "    fi\n"
+    "}\n"
+    "compdef _" IDENT " " NAME "\n"
+    "# complete right away when autoloaded from $fpath rather than sourced\n"
+    "if [ \"$funcstack[1]\" = \"_" IDENT "\" ]; then _" IDENT " \"$@\"; fi\n";
+
+static const char* const g_fish_script =
+    "# fish completion for " NAME ", generated by argparse\n"
+    "function __" IDENT "_complete\n"
+    "    set -l words (commandline -opc)\n"
+    "    set -l current (commandline -ct)\n"
+    "    $words[1] " ARGPARSE_COMPLETE_COMMAND " $words[2..-1] \"$current\" 2>/dev/null\n"
+    "end\n"
+    "complete -c " NAME " -a '(__" IDENT "_complete)'\n";
+
+static bool is_ident_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+/* Characters a command name may use without quoting in any of the scripts. */
+static bool is_name_char(char c) {
+    return is_ident_char(c) || c == '-' || c == '.' || c == '+';
+}
+
+/* Writes a template, NAME as the command and IDENT as the command with '_' for punctuation. */
+static void write_script(FILE* out, const char* text, const char* name) {
+    for (; *text; text++) {
+        if (*text == NAME[0])
+            fputs(name, out);
+        else if (*text == IDENT[0]) {
+            for (const char* c = name; *c; c++)
+                fputc(is_ident_char(*c) ? *c : '_', out);
+        }
+        else
+            fputc(*text, out);
+    }
+}
+
+bool argparse_print_completion(ArgParser* parser, ArgShell shell) {
+    argparse_error_clear();
+
+    if (!parser || (shell != ARGPARSE_SHELL_BASH && shell != ARGPARSE_SHELL_ZSH &&
+        shell != ARGPARSE_SHELL_FISH)) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser or shell.");
+        return false;
+    }
+
+    if (!parser->program_name) {
+        APE_SET(APE_CONFIG, EINVAL, NULL, "Program name is unknown, parse argv first.");
+        return false;
+    }
+
+    /* the command as typed at the prompt, without its directory */
+    const char* name = parser->program_name;
+
+    for (const char* c = name; *c; c++) {
+        if (*c == '/' || *c == '\\') name = c + 1;
+    }
+
+    for (const char* c = name; *c; c++) {
+        if (!is_name_char(*c)) {
+            APE_SET(APE_CONFIG, EINVAL, name, "Program name cannot be used in a completion script.");
+            return false;
+        }
+    }
+
+    if (name[0] == '\0') {
+        APE_SET(APE_CONFIG, EINVAL, NULL, "Program name cannot be used in a completion script.");
+        return false;
+    }
+
+    const char* script = shell == ARGPARSE_SHELL_BASH ? g_bash_script
+        : shell == ARGPARSE_SHELL_ZSH ? g_zsh_script : g_fish_script;
+
+    write_script(stdout, script, name);
+    return true;
+}
+
+/* One candidate line; the help is cut at its first line, tabs would split the line. */
+static void write_candidate(FILE* out, const char* name, const char* help) {
+    fputs(name, out);
+
+    size_t help_len = help ? strcspn(help, "\t\r\n") : 0;
+
+    if (help_len) {
+        fputc('\t', out);
+        fwrite(help, 1, help_len, out);
+    }
+
+    fputc('\n', out);
+}
+
+/* True for a registered option that consumes the next word as its value. */
+static bool takes_value(ArgParser* parser, const char* word) {
+    if (word[0] != '-') return false;
+
+    const Argument* arg = argparse_hash_find_argument(parser, word);
+    return arg && arg->type != ARG_BOOL && !arg->is_list;
+}
+
+/* A lone GNU suffix, as bash splits "--output=" into "--output" and "=". */
+static bool is_suffix_word(const ArgParser* parser, const char* word) {
+    return word[0] != '\0' && word[1] == '\0' && strchr(parser->suffix_chars, word[0]);
+}
+
+size_t argparse_complete(ArgParser* parser, int count, char** words, FILE* out) {
+    argparse_error_clear();
+
+    if (!parser || count < 0 || (count > 0 && !words) || !out) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser, words or stream.");
+        return 0;
+    }
+
+    /* the words before the last one only select the parser, they are not converted */
+    for (int i = 0; i + 1 < count; i++) {
+        const char* word = words[i];
+
+        /* everything after "--" is a value */
+        if (strcmp(word, "--") == 0)
+            return 0;
+
+        if (takes_value(parser, word)) {
+            i++;
+            continue;
+        }
+
+        if (word[0] == '-') continue;
+
+        for (ArgSubcommand* sub = parser->subcommands; sub; sub = sub->next) {
+            if (strcmp(sub->name, word) != 0) continue;
+
+            if (!sub->parser && !(sub->parser = sub->builder(sub->user_data)))
+                return 0;
+
+            return argparse_complete(sub->parser, count - i - 1, words + i + 1, out);
+        }
+    }
+
+    const char* current = count > 0 ? words[count - 1] : "";
+    const char* previous = count > 1 ? words[count - 2] : NULL;
+
+    /* values are left to the shell, which offers file names instead */
+    if ((previous && (takes_value(parser, previous) || is_suffix_word(parser, previous))) ||
+        is_suffix_word(parser, current) ||
+        (current[0] == '-' && strpbrk(current, parser->suffix_chars)))
+        return 0;
+
+    size_t len = strlen(current), written = 0;
+
+    if (current[0] != '-') {
+        for (const ArgSubcommand* sub = parser->subcommands; sub; sub = sub->next) {
+            if (strncmp(sub->name, current, len) == 0) {
+                write_candidate(out, sub->name, sub->help);
+                written++;
+            }
+        }
+
+        return written;
+    }
+
+    /* the built-in help is recognised without being registered, except in spec parsers */
+    if (parser->help_added && !argparse_hash_find_argument(parser, "--help")) {
+        static const char* const help_names[] = { "-h", "--help" };
+
+        for (size_t i = 0; i < 2; i++) {
+            if (strncmp(help_names[i], current, len) == 0) {
+                write_candidate(out, help_names[i], "Show this help message and exit");
+                written++;
+            }
+        }
+    }
+
+    /* one binary search for the stem, then only the names spelled with these dashes */
+    const ArgNameIndex* index = argparse_hash_name_index(parser);
+    if (!index) return written;
+
+    size_t dashes = strspn(current, "-"), first;
+    size_t matches = argparse_name_index_prefix_internal(index, current + dashes, len - dashes,
+        &first);
+
+    for (size_t i = first; i < first + matches; i++) {
+        const ArgNameEntry* entry = &index->entries[i];
+
+        if (strncmp(entry->name, current, len) == 0) {
+            write_candidate(out, entry->name, entry->argument->help);
+            written++;
+        }
+    }
+
+    return written;
+}
+
+bool argparse_completion_requested(const ArgParser* parser) {
+    return parser && parser->completion_requested;
+}
@@ -6,6 +6,11 @@
 /* Simplified thread-local error state. */
 #if defined(_MSC_VER)
 #define THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+/* -std=c99 has no _Thread_local, GCC and Clang still offer __thread */
+#define THREAD_LOCAL __thread
 #else
 #define THREAD_LOCAL _Thread_local
 #endif
@@ -15,6 +20,15 @@ static THREAD_LOCAL ArgParseError g_last_error = { 0 };
 static THREAD_LOCAL char g_message_buffer[512] = { 0 };
 static THREAD_LOCAL bool g_error_occurred = false;
 
+/* Argument names may belong to a parser freed before the message is read. */
+static THREAD_LOCAL char g_argument_buffer[128] = { 0 };
+
+/* Optional suggestion appended to the message, e.g. "did you mean '--verbose'?". */
+static THREAD_LOCAL char g_hint_buffer[160] = { 0 };
+
+/* g_message_buffer is formatted on first read, not when the error is recorded. */
+static THREAD_LOCAL bool g_message_ready = true;
+
 void argparse_error_set(ArgParseErrorCategory category, int errno_val,
     const char* func, int line, const char* arg_name, const char* user_msg) {
     /* set errno for better compatibility */
@@ -26,11 +40,49 @@ void argparse_error_set(ArgParseErrorCategory category, int errno_val,
     g_last_error.function_name = func;
     g_last_error.line_number = line;
 
-    g_last_error.argument_name = arg_name ? arg_name : "";
+    /* keep a bounded copy of the name, the message text is a literal */
+    if (arg_name && arg_name[0] != '\0') {
+        size_t len = strlen(arg_name);
+        if (len >= sizeof(g_argument_buffer)) len = sizeof(g_argument_buffer) - 1;
+
+        memcpy(g_argument_buffer, arg_name, len);
+        g_argument_buffer[len] = '\0';
+        g_last_error.argument_name = g_argument_buffer;
+    }
+    else
+        g_last_error.argument_name = "";
+
     g_last_error.user_message = user_msg ? user_msg : "";
+    g_hint_buffer[0] = '\0';
+
+    g_message_ready = false;
+    g_error_occurred = true;
+}
 
-    /* format full message */
-    const char* category_str = argparse_error_category_to_string(category);
+void argparse_error_clear(void) {
+    /* called on entry to nearly every function: a no-op beyond errno when already clean */
+    if (g_error_occurred) {
+        g_last_error.category = APE_SUCCESS;
+        g_last_error.errno_value = 0;
+        g_last_error.function_name = NULL;
+        g_last_error.line_number = 0;
+        g_last_error.argument_name = NULL;
+        g_last_error.user_message = NULL;
+
+        g_message_buffer[0] = '\0';
+        g_hint_buffer[0] = '\0';
+        g_message_ready = true;
+        g_error_occurred = false;
+    }
+
+    errno = 0;
+}
+
+/* Builds the human-readable message from the recorded error fields. */
+static void format_message(void) {
+    const char* category_str = argparse_error_category_to_string(g_last_error.category);
+    const char* arg_name = g_last_error.argument_name;
+    const char* user_msg = g_last_error.user_message;
 
     if (user_msg && user_msg[0] != '\0') {
         if (arg_name && arg_name[0] != '\0') {
@@ -53,15 +105,24 @@ void argparse_error_set(ArgParseErrorCategory category, int errno_val,
         }
     }
 
-    g_error_occurred = true;
+    if (g_hint_buffer[0] != '\0') {
+        size_t used = strlen(g_message_buffer);
+        snprintf(g_message_buffer + used, sizeof(g_message_buffer) - used, " (%s)", g_hint_buffer);
+    }
+
+    g_message_ready = true;
 }
 
-void argparse_error_clear(void) {
-    memset(&g_last_error, 0, sizeof(ArgParseError));
-    g_message_buffer[0] = '\0';
+void argparse_error_set_hint(const char* hint) {
+    if (!g_error_occurred || !hint) return;
 
-    g_error_occurred = false;
-    errno = 0;
+    /* bounded copy, callers format the hint in a local buffer */
+    snprintf(g_hint_buffer, sizeof(g_hint_buffer), "%s", hint);
+    g_message_ready = false;
+}
+
+const char* argparse_error_get_hint(void) {
+    return g_hint_buffer;
 }
 
 ArgParseErrorCategory argparse_error_get_category(void) {
@@ -73,6 +134,8 @@ int argparse_error_get_errno(void) {
 }
 
 const char* argparse_error_get_message(void) {
+    if (!g_message_ready)
+        format_message();
     return g_message_buffer;
 }
 
@@ -1,47 +1,91 @@
+/* syscall() and clock_gettime() are hidden by strict -std=c99 on glibc. */
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 #include "argparse.h"
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
 #ifdef _WIN32
 #include <windows.h>
 #include <process.h>
 #define getpid _getpid
 #else
 #include <sys/time.h>
+#include <fcntl.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #ifdef __APPLE__
 #include <mach/mach_time.h>
+#include <pthread.h>
 #endif
 #endif
 
-/* Return secure random seed, using portable generator. */
-static uint32_t secure_random_seed(ArgHashTable* table) {
-    uint32_t seed = 0;
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#define ARGPARSE_HAVE_ARC4RANDOM 1
+#endif
 
-    /* try OS-specific secure random */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+static _Atomic uint32_t g_process_seed = 0;
+#define PROCESS_SEED_LOAD() atomic_load_explicit(&g_process_seed, memory_order_relaxed)
+#define PROCESS_SEED_STORE(v) atomic_store_explicit(&g_process_seed, (v), memory_order_relaxed)
+#else
+/* racing first calls just store two valid seeds, the last one wins */
+static volatile uint32_t g_process_seed = 0;
+#define PROCESS_SEED_LOAD() (g_process_seed)
+#define PROCESS_SEED_STORE(v) (g_process_seed = (v))
+#endif
+
+/* Fill a seed from the OS CSPRNG without stdio; false if unavailable. */
+static bool os_random_seed(uint32_t* seed) {
 #ifdef _WIN32
     /* Windows CryptGenRandom */
     HCRYPTPROV hCryptProv = 0;
     if (CryptAcquireContextW(&hCryptProv, NULL, NULL,
         PROV_RSA_FULL, CRYPT_VERIFYCONTEXT)) {
-        if (CryptGenRandom(hCryptProv, sizeof(seed), (BYTE*)&seed)) {
+        if (CryptGenRandom(hCryptProv, sizeof(*seed), (BYTE*)seed)) {
             CryptReleaseContext(hCryptProv, 0);
-            if (seed != 0) return seed;
+            return true;
         }
         CryptReleaseContext(hCryptProv, 0);
     }
+    return false;
+#elif defined(ARGPARSE_HAVE_ARC4RANDOM)
+    /* never fails and never touches a file descriptor */
+    arc4random_buf(seed, sizeof(*seed));
+    return true;
 #else
-    /* Unix /dev/urandom */
-    FILE* urandom = fopen("/dev/urandom", "rb");
-    if (urandom) {
-        if (fread(&seed, sizeof(seed), 1, urandom) == 1) {
-            fclose(urandom);
-            return seed;
-        }
-        fclose(urandom);
-    }
+#if defined(__linux__) && defined(SYS_getrandom)
+    /* single syscall, non-blocking once the pool is initialized */
+    if (syscall(SYS_getrandom, seed, sizeof(*seed), 0) == (long)sizeof(*seed))
+        return true;
+#endif
+    /* raw descriptor instead of FILE*: no stdio buffer allocation */
+    int fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0) return false;
+
+    ssize_t got = read(fd, seed, sizeof(*seed));
+    close(fd);
+    return got == (ssize_t)sizeof(*seed);
 #endif
+}
+
+/* Return secure random seed, using portable generator. */
+static uint32_t secure_random_seed(ArgHashTable* table) {
+    uint32_t seed = 0;
+
+    /* try OS-specific secure random */
+    if (os_random_seed(&seed) && seed != 0)
+        return seed;
 
     /* high-resolution timer combination */
     uint64_t highres_time = 0;
@@ -116,53 +160,168 @@ static uint32_t secure_random_seed(ArgHashTable* table) {
     return seed ? seed : 0xDEADBEEFU;
 }
 
-/* Security-enhanced FNV-1a hash with randomization. */
-static uint32_t hash_string(const char* str, uint32_t seed) {
-    if (!str) return 0;
+/* Resolve the seed for a new table according to the parser's policy. */
+static uint32_t select_seed(ArgHashTable* table, ArgHashSeedPolicy policy) {
+    switch (policy) {
+    case ARGPARSE_SEED_FIXED:
+        return ARGPARSE_HASH_FIXED_SEED;
+
+    case ARGPARSE_SEED_PROCESS: {
+        uint32_t seed = PROCESS_SEED_LOAD();
+
+        /* first table in the process pays for the entropy */
+        if (seed == 0) {
+            seed = secure_random_seed(table);
+            PROCESS_SEED_STORE(seed);
+        }
+        return seed;
+    }
+
+    case ARGPARSE_SEED_SECURE:
+    default:
+        return secure_random_seed(table);
+    }
+}
+
+/* Multiplicative mixing constants (wyhash secrets, odd and well spread). */
+#define HASH_SECRET0 0xa0761d6478bd642fULL
+#define HASH_SECRET1 0xe7037ed1a0b428dbULL
+#define HASH_SECRET2 0x8ebc6af09c88c6e3ULL
+#define HASH_SECRET3 0x589965cc75374cc3ULL
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 hash_u128;
+#endif
+
+/* Folded 64x64->128 multiply: every input bit reaches every output bit. */
+static uint64_t hash_mum(uint64_t a, uint64_t b) {
+#if defined(__SIZEOF_INT128__)
+    hash_u128 product = (hash_u128)a * b;
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    uint64_t high;
+    uint64_t low = _umul128(a, b, &high);
+    return low ^ high;
+#else
+    uint64_t a_lo = a & 0xffffffffULL, a_hi = a >> 32;
+    uint64_t b_lo = b & 0xffffffffULL, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo;
+    uint64_t lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffffULL) + lo_hi;
+    uint64_t low = (cross << 32) | (lo_lo & 0xffffffffULL);
+    uint64_t high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    return low ^ high;
+#endif
+}
+
+/* Little-endian word of 8 bytes, so generated indices hash alike on every host. */
+static uint64_t hash_read64(const char* data) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || \
+    defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    return word;
+#else
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint64_t word = 0;
+
+    for (int i = 7; i >= 0; i--)
+        word = (word << 8) | bytes[i];
+    return word;
+#endif
+}
+
+/* The seed keys every step, so colliding names cannot be precomputed (HashDoS). */
+static uint64_t hash_start(uint32_t seed) {
+    return (((uint64_t)seed << 32) | seed) ^ HASH_SECRET0;
+}
+
+static uint64_t hash_word(uint64_t state, uint64_t word) {
+    return hash_mum(state ^ word, HASH_SECRET1);
+}
+
+/* Mixes the last 0..7 bytes (zero padded, little-endian) and the length. */
+static uint32_t hash_finish(uint64_t state, uint64_t tail, size_t len) {
+    state = hash_mum(state ^ tail ^ HASH_SECRET2, (uint64_t)len ^ HASH_SECRET3);
+    state = hash_mum(state, HASH_SECRET1);
+    return (uint32_t)(state ^ (state >> 32));
+}
+
+/* Seeded word-at-a-time hash (wyhash-style multiply-fold). */
+uint32_t argparse_hash_bytes_internal(const char* data, size_t len, uint32_t seed) {
+    if (!data) return 0;
 
-    /* FNV-1a constants */
-    const uint32_t FNV_PRIME = 16777619U;
-    const uint32_t FNV_OFFSET_BASIS = 2166136261U;
+    uint64_t state = hash_start(seed);
+    size_t i = 0;
 
-    /* start with randomized basis */
-    uint32_t hash = FNV_OFFSET_BASIS ^ seed;
+    /* process exactly len bytes, the key need not be terminated */
+    for (; len - i >= 8; i += 8)
+        state = hash_word(state, hash_read64(data + i));
 
-    /* process full string */
-    while (*str) {
-        hash ^= (uint32_t)(*str++);
-        hash *= FNV_PRIME;
+    uint64_t tail = 0;
+    for (size_t shift = 0; i < len; i++, shift += 8)
+        tail |= (uint64_t)(unsigned char)data[i] << shift;
+
+    return hash_finish(state, tail, len);
+}
+
+uint32_t argparse_hash_string_len_internal(const char* str, uint32_t seed, size_t* len) {
+    if (!str) {
+        *len = 0;
+        return 0;
     }
 
-    /* final mixing for better distribution */
-    hash ^= hash >> 16;
-    hash *= 0x85ebca6b;
-    hash ^= hash >> 13;
-    hash *= 0xc2b2ae35;
-    hash ^= hash >> 16;
+    /* libc's vectorized strlen() plus whole-word loads beat a fused byte loop; the
+       length is measured once here and handed on, probes never rescan the key */
+    *len = strlen(str);
+    return argparse_hash_bytes_internal(str, *len, seed);
+}
+
+uint32_t argparse_hash_string_internal(const char* str, uint32_t seed) {
+    size_t len;
+    return argparse_hash_string_len_internal(str, seed, &len);
+}
+
+/* Arguments that are not covered by a static spec index. */
+static Argument* first_dynamic_argument(ArgParser* parser) {
+    return parser->spec_tail ? parser->spec_tail->next : parser->arguments;
+}
+
+/* Smallest power-of-two capacity keeping `entries` under the load factor. */
+static size_t capacity_for(size_t entries) {
+    size_t capacity = ARGPARSE_HASH_MIN_CAPACITY;
+
+    while ((float)entries > (float)capacity * ARGPARSE_HASH_LOAD_FACTOR) {
+        /* overflow check for safety */
+        if (capacity > SIZE_MAX / 2) return 0;
+        capacity *= 2;
+    }
 
-    return hash;
+    return capacity;
 }
 
-ArgHashTable* argparse_hash_create_internal(void) {
-    ArgHashTable* table = (ArgHashTable*)calloc(1, sizeof(ArgHashTable));
+ArgHashTable* argparse_hash_create_internal(ArgArena* arena, ArgHashSeedPolicy policy,
+    size_t expected_entries) {
+    ArgHashTable* table = (ArgHashTable*)argparse_arena_calloc(arena, 1, sizeof(ArgHashTable));
     if (!table) {
         APE_SET_MEMORY(NULL);
         return NULL;
     }
 
-    /* initialize with default capacity */
-    table->capacity = ARGPARSE_HASH_TABLE_SIZE;
-    table->buckets = (HashEntry**)calloc(table->capacity, 
-        sizeof(HashEntry*));
+    /* size the slot array to the expected number of names */
+    table->arena = arena;
+    table->capacity = capacity_for(expected_entries);
+    table->slots = table->capacity ? (HashEntry*)argparse_arena_calloc(arena,
+        table->capacity, sizeof(HashEntry)) : NULL;
 
-    if (!table->buckets) {
+    if (!table->slots) {
         APE_SET_MEMORY(NULL);
-        free(table);
+        argparse_arena_free(arena, table);
         return NULL;
     }
 
-    /* Generate secure random seed */
-    table->seed = secure_random_seed(table);
+    /* generate the seed according to policy */
+    table->seed = select_seed(table, policy);
     table->size = 0;
     return table;
 }
@@ -170,20 +329,35 @@ ArgHashTable* argparse_hash_create_internal(void) {
 void argparse_hash_destroy_internal(ArgHashTable* table) {
     if (!table) return;
 
-    /* free all entries */
-    for (size_t i = 0; i < table->capacity; i++) {
-        HashEntry* entry = table->buckets[i];
+    /* arena storage is released together with the parser */
+    if (table->arena) return;
 
-        while (entry) {
-            HashEntry* next = entry->next;
-            free(entry->key);
-            free(entry);
-            entry = next;
+    /* keys are borrowed from their arguments, entries live inline */
+    free(table->slots);
+    free(table);
+}
+
+/* Linear probe for a key; returns its slot or the empty slot ending the run. */
+static HashEntry* probe_slot(const ArgHashTable* table, const char* key,
+    size_t key_len, uint32_t hash) {
+    size_t mask = table->capacity - 1;
+    size_t index = hash & mask;
+
+    while (table->slots[index].argument) {
+        HashEntry* entry = &table->slots[index];
+
+        /* cached hash and length reject nearly every mismatch before memcmp */
+        if (entry->hash == hash && entry->key_len == key_len) {
+            ARGPARSE_STATS_ADD(string_compares, 1);
+
+            if (memcmp(entry->key, key, key_len) == 0)
+                return entry;
         }
+
+        index = (index + 1) & mask;
     }
 
-    free(table->buckets);
-    free(table);
+    return &table->slots[index];
 }
 
 /* Resize hash table when load factor exceeds threshold. */
@@ -202,36 +376,31 @@ static bool hash_table_resize(ArgHashTable* table) {
     if (new_capacity < table->capacity) 
         return false;
 
-    HashEntry** new_buckets = (HashEntry**)calloc(new_capacity, 
-        sizeof(HashEntry*));
+    HashEntry* new_slots = (HashEntry*)argparse_arena_calloc(table->arena,
+        new_capacity, sizeof(HashEntry));
 
-    if (!new_buckets) {
+    if (!new_slots) {
         APE_SET_MEMORY(NULL);
         return false;
     }
 
-    /* rehash all existing entries */
-    for (size_t i = 0; i < table->capacity; i++) {
-        HashEntry* entry = table->buckets[i];
+    /* reinsert with cached hashes, no key is rehashed */
+    size_t mask = new_capacity - 1;
 
-        while (entry) {
-            HashEntry* next = entry->next;
-
-            /* recompute hash with new capacity */
-            uint32_t hash = hash_string(entry->key, table->seed);
-            size_t new_index = hash & (new_capacity - 1);
+    for (size_t i = 0; i < table->capacity; i++) {
+        HashEntry* entry = &table->slots[i];
+        if (!entry->argument) continue;
 
-            /* insert into new bucket */
-            entry->next = new_buckets[new_index];
-            new_buckets[new_index] = entry;
+        size_t index = entry->hash & mask;
+        while (new_slots[index].argument)
+            index = (index + 1) & mask;
 
-            entry = next;
-        }
+        new_slots[index] = *entry;
     }
 
-    /* replace old buckets */
-    free(table->buckets);
-    table->buckets = new_buckets;
+    /* replace old slots */
+    argparse_arena_free(table->arena, table->slots);
+    table->slots = new_slots;
 
     table->capacity = new_capacity;
     return true;
@@ -247,55 +416,53 @@ bool argparse_hash_insert_internal(ArgHashTable* table, const char* key, Argumen
         return false;
     }
 
+    /* one pass yields both the hash and the length */
+    size_t key_len;
+    uint32_t hash = argparse_hash_string_len_internal(key, table->seed, &key_len);
+
+    if (key_len > UINT32_MAX) {
+        APE_SET_RANGE(key, "Argument name too long.");
+        return false;
+    }
+
     /* check load factor and resize if needed */
-    float load_factor = (float)table->size / (float)table->capacity;
+    float load_factor = (float)(table->size + 1) / (float)table->capacity;
     if (load_factor > ARGPARSE_HASH_LOAD_FACTOR) {
         if (!hash_table_resize(table))
             return false;
     }
 
-    /* compute hash and bucket index */
-    uint32_t hash = hash_string(key, table->seed);
-    size_t index = hash & (table->capacity - 1);
-
-    /* check for duplicates in this bucket */
-    HashEntry* current = table->buckets[index];
-
-    while (current) {
-        /* update existing entry */
-        if (strcmp(current->key, key) == 0) {
-            current->argument = arg;
-            return true;
-        }
-
-        current = current->next;
-    }
-
-    /* create new entry */
-    HashEntry* new_entry = (HashEntry*)malloc(sizeof(HashEntry));
-    if (!new_entry) {
-        APE_SET_MEMORY(key);
-        return false;
-    }
+    /* find the key or its insertion slot */
+    HashEntry* entry = probe_slot(table, key, key_len, hash);
 
-    /* duplicate the key */
-    new_entry->key = strdup(key);
-    if (!new_entry->key) {
-        APE_SET_MEMORY(key);
-        free(new_entry);
-        return false;
+    /* update existing entry */
+    if (entry->argument) {
+        entry->argument = arg;
+        return true;
     }
 
-    /* insert at head of bucket */
-    new_entry->argument = arg;
-    new_entry->next = table->buckets[index];
-    table->buckets[index] = new_entry;
+    /* the key is borrowed: it is the argument's own name string */
+    entry->hash = hash;
+    entry->key_len = (uint32_t)key_len;
+    entry->key = key;
+    entry->argument = arg;
     table->size++;
 
     return true;
 }
 
 Argument* argparse_hash_lookup_internal(ArgHashTable* table, const char* key) {
+    if (!table || !key)
+        return argparse_hash_lookup_internal_n(table, key, 0);
+
+    argparse_error_clear();
+
+    size_t len;
+    uint32_t hash = argparse_hash_string_len_internal(key, table->seed, &len);
+    return probe_slot(table, key, len, hash)->argument;
+}
+
+Argument* argparse_hash_lookup_internal_n(ArgHashTable* table, const char* key, size_t len) {
     /* clear previous error, lookup failure is normal */
     argparse_error_clear();
 
@@ -305,20 +472,9 @@ Argument* argparse_hash_lookup_internal(ArgHashTable* table, const char* key) {
         return NULL;
     }
 
-    /* compute hash and bucket index */
-    uint32_t hash = hash_string(key, table->seed);
-    size_t index = hash & (table->capacity - 1);
-
-    /* search in bucket chain */
-    HashEntry* entry = table->buckets[index];
-
-    while (entry) {
-        if (strcmp(entry->key, key) == 0)
-            return entry->argument;
-        entry = entry->next;
-    }
-
-    return NULL;
+    /* compute hash, then probe until a match or an empty slot */
+    uint32_t hash = argparse_hash_bytes_internal(key, len, table->seed);
+    return probe_slot(table, key, len, hash)->argument;
 }
 
 bool ensure_hash_table_built(ArgParser* parser) {
@@ -337,14 +493,16 @@ bool ensure_hash_table_built(ArgParser* parser) {
     if (parser->argument_count < ARGPARSE_HASH_THRESHOLD)
         return false;
 
-    parser->hash_table = argparse_hash_create_internal();
+    /* every argument contributes up to two names */
+    parser->hash_table = argparse_hash_create_internal(parser->arena,
+        parser->seed_policy, parser->argument_count * 2);
 
     if (!parser->hash_table) {
         APE_SET(APE_MEMORY, ENOMEM, NULL, "Failed to create hash table.");
         return false;
     }
 
-    Argument* current = parser->arguments;
+    Argument* current = first_dynamic_argument(parser);
 
     while (current) {
         if (current->short_name)
@@ -358,27 +516,60 @@ bool ensure_hash_table_built(ArgParser* parser) {
     return true;
 }
 
+/* True when a stored name equals the first len bytes of name. */
+static bool name_matches(const char* candidate, const char* name, size_t len) {
+    if (!candidate) return false;
+
+    ARGPARSE_STATS_ADD(string_compares, 1);
+    return strncmp(candidate, name, len) == 0 && candidate[len] == '\0';
+}
+
 Argument* argparse_hash_find_argument(ArgParser* parser, const char* name) {
+    /* a plain runtime table measures and hashes the name in the same pass */
+    if (parser && name && name[0] != '\0' && !parser->spec_index &&
+        parser->hash_enabled && parser->hash_table) {
+        argparse_error_clear();
+        ARGPARSE_STATS_ADD(hash_lookups, 1);
+
+        size_t len;
+        uint32_t hash = argparse_hash_string_len_internal(name, parser->hash_table->seed, &len);
+        return probe_slot(parser->hash_table, name, len, hash)->argument;
+    }
+
+    return argparse_hash_find_argument_n(parser, name, name ? strlen(name) : 0);
+}
+
+Argument* argparse_hash_find_argument_n(ArgParser* parser, const char* name, size_t len) {
     /* clear previous error */
     argparse_error_clear();
 
-    if (!parser || !name || name[0] == '\0') {
+    if (!parser || !name || len == 0) {
         APE_SET(APE_INTERNAL, EINVAL, name ? name : "(null)",
             "Invalid parameters to argument lookup.");
         return NULL;
     }
 
+    ARGPARSE_STATS_ADD(hash_lookups, 1);
+
+    /* static spec names resolve with a single probe */
+    if (parser->spec_index) {
+        Argument* found = argparse_spec_lookup_internal(parser, name, len);
+
+        if (found || !parser->spec_tail->next)
+            return found;
+    }
+
     /* use hash table if enabled */
     if (parser->hash_enabled && parser->hash_table)
-        return argparse_hash_lookup_internal(parser->hash_table, 
-            name);
+        return argparse_hash_lookup_internal_n(parser->hash_table,
+            name, len);
 
     /* fallback to linear search */
-    Argument* arg = parser->arguments;
+    Argument* arg = first_dynamic_argument(parser);
 
     while (arg) {
-        if (arg->short_name && strcmp(arg->short_name, name) == 0) return arg;
-        if (arg->long_name && strcmp(arg->long_name, name) == 0) return arg;
+        if (name_matches(arg->short_name, name, len)) return arg;
+        if (name_matches(arg->long_name, name, len)) return arg;
         arg = arg->next;
     }
 
@@ -396,19 +587,282 @@ bool argparse_hash_is_argument(ArgParser* parser, const char* str) {
         return false;
     }
 
-    /* use hash table if enabled */
-    if (parser->hash_enabled && parser->hash_table)
-        return argparse_hash_lookup_internal(parser->hash_table, str) != NULL;
+    /* same strategy selection as the primary lookup */
+    return argparse_hash_find_argument(parser, str) != NULL;
+}
 
-    /* fallback to linear search */
-    Argument* arg = parser->arguments;
+static int name_entry_order(const void* a, const void* b) {
+    const ArgNameEntry* left = (const ArgNameEntry*)a;
+    const ArgNameEntry* right = (const ArgNameEntry*)b;
+    int order = strcmp(left->stem, right->stem);
 
-    while (arg) {
-        if (arg->short_name && strcmp(arg->short_name, str) == 0) return true;
-        if (arg->long_name && strcmp(arg->long_name, str) == 0) return true;
-        arg = arg->next;
+    /* equal stems keep a fixed order: fewer dashes first */
+    return order ? order : strcmp(right->name, left->name);
+}
+
+ArgNameIndex* argparse_name_index_create_internal(ArgArena* arena, Argument* arguments) {
+    size_t count = 0;
+
+    for (const Argument* arg = arguments; arg; arg = arg->next)
+        count += (arg->short_name != NULL) + (arg->long_name != NULL);
+
+    ArgNameIndex* index = (ArgNameIndex*)argparse_arena_calloc(arena, 1, sizeof(ArgNameIndex));
+    ArgNameEntry* entries = index ? (ArgNameEntry*)argparse_arena_calloc(arena,
+        count ? count : 1, sizeof(ArgNameEntry)) : NULL;
+
+    if (!entries) {
+        argparse_arena_free(arena, index);
+        APE_SET_MEMORY(NULL);
+        return NULL;
     }
-    
-    /* not an argument */
-    return false;
+
+    index->entries = entries;
+    index->arena = arena;
+
+    for (Argument* arg = arguments; arg; arg = arg->next) {
+        const char* names[2] = { arg->short_name, arg->long_name };
+
+        for (int i = 0; i < 2; i++) {
+            if (!names[i]) continue;
+
+            ArgNameEntry* entry = &entries[index->count++];
+            entry->name = names[i];
+            entry->stem = names[i] + strspn(names[i], "-");
+            entry->stem_len = strlen(entry->stem);
+            entry->argument = arg;
+        }
+    }
+
+    /* one contiguous sort, then every search is a binary search */
+    qsort(entries, index->count, sizeof(ArgNameEntry), name_entry_order);
+    return index;
+}
+
+void argparse_name_index_destroy_internal(ArgNameIndex* index) {
+    /* arena storage is released together with its owner */
+    if (!index || index->arena) return;
+
+    free(index->entries);
+    free(index);
+}
+
+/* First entry whose stem is not ordered before the len bytes of key, compared as a prefix. */
+static size_t name_lower_bound(const ArgNameIndex* index, const char* key, size_t len) {
+    size_t low = 0, high = index->count;
+
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        const ArgNameEntry* entry = &index->entries[mid];
+
+        ARGPARSE_STATS_ADD(string_compares, 1);
+
+        /* a stem equal to the key over len bytes is not before it */
+        size_t shared = entry->stem_len < len ? entry->stem_len : len;
+        int order = memcmp(entry->stem, key, shared);
+
+        if (order < 0 || (order == 0 && entry->stem_len < len)) low = mid + 1;
+        else high = mid;
+    }
+
+    return low;
+}
+
+size_t argparse_name_index_prefix_internal(const ArgNameIndex* index, const char* prefix,
+    size_t len, size_t* first) {
+    size_t start = name_lower_bound(index, prefix, len), end = start;
+
+    /* every name with the prefix sorts right after the lower bound */
+    while (end < index->count && index->entries[end].stem_len >= len &&
+        memcmp(index->entries[end].stem, prefix, len) == 0)
+        end++;
+
+    *first = start;
+    return end - start;
+}
+
+/* Edit distance with adjacent transpositions, or limit + 1 once it must exceed limit. */
+static size_t bounded_distance(const char* a, size_t a_len, const char* b, size_t b_len,
+    size_t limit) {
+    size_t rows[3][ARGPARSE_SUGGEST_MAX_LEN + 1];
+    size_t *before = rows[0], *previous = rows[1], *current = rows[2];
+
+    if ((a_len > b_len ? a_len - b_len : b_len - a_len) > limit)
+        return limit + 1;
+
+    for (size_t j = 0; j <= b_len; j++)
+        previous[j] = j;
+
+    for (size_t i = 1; i <= a_len; i++) {
+        size_t best = current[0] = i;
+
+        for (size_t j = 1; j <= b_len; j++) {
+            size_t cost = a[i - 1] != b[j - 1];
+            size_t value = previous[j - 1] + cost;
+
+            if (previous[j] + 1 < value) value = previous[j] + 1;
+            if (current[j - 1] + 1 < value) value = current[j - 1] + 1;
+            if (i > 1 && j > 1 && a[i - 1] == b[j - 2] && a[i - 2] == b[j - 1] &&
+                before[j - 2] + 1 < value)
+                value = before[j - 2] + 1;
+
+            current[j] = value;
+            if (value < best) best = value;
+        }
+
+        /* no later row can get back under the limit */
+        if (best > limit)
+            return limit + 1;
+
+        size_t* oldest = before;
+        before = previous;
+        previous = current;
+        current = oldest;
+    }
+
+    return previous[b_len];
+}
+
+const ArgNameEntry* argparse_name_index_suggest_internal(const ArgNameIndex* index,
+    const char* name) {
+    size_t len = strlen(name);
+
+    /* one- and two-letter names are close to almost everything */
+    if (len < 4 || len > ARGPARSE_SUGGEST_MAX_LEN || index->count == 0)
+        return NULL;
+
+    /* roughly one edit per four characters, at most three */
+    size_t limit = len <= 5 ? 1 : len <= 11 ? 2 : 3;
+
+    const char* stem = name + strspn(name, "-");
+    size_t middle = name_lower_bound(index, stem, strlen(stem));
+    size_t start = middle > ARGPARSE_SUGGEST_WINDOW ? middle - ARGPARSE_SUGGEST_WINDOW : 0;
+    size_t end = index->count - middle > ARGPARSE_SUGGEST_WINDOW
+        ? middle + ARGPARSE_SUGGEST_WINDOW : index->count;
+
+    const ArgNameEntry* best = NULL;
+
+    for (size_t i = start; i < end; i++) {
+        const ArgNameEntry* entry = &index->entries[i];
+        size_t entry_len = (size_t)(entry->stem - entry->name) + entry->stem_len;
+        if (entry_len < 4 || entry_len > ARGPARSE_SUGGEST_MAX_LEN) continue;
+
+        /* whole names are compared, a missing dash is one edit */
+        size_t distance = bounded_distance(name, len, entry->name, entry_len, limit);
+
+        /* later candidates must be strictly closer */
+        if (distance <= limit) {
+            best = entry;
+            limit = distance ? distance - 1 : 0;
+            if (distance == 0) break;
+        }
+    }
+
+    return best;
+}
+
+const ArgNameIndex* argparse_hash_name_index(ArgParser* parser) {
+    if (!parser) return NULL;
+
+    /* built over the parser's own list: schema arguments, or a view's copies */
+    if (!parser->name_index)
+        parser->name_index = argparse_name_index_create_internal(parser->arena,
+            parser->arguments);
+
+    return parser->name_index;
+}
+
+void argparse_hash_invalidate_name_index(ArgParser* parser) {
+    if (!parser || !parser->name_index) return;
+
+    /* arena parsers keep the stale copy until argparse_free(), adds are rare after parses */
+    argparse_name_index_destroy_internal(parser->name_index);
+    parser->name_index = NULL;
+}
+
+ArgInternPool* argparse_intern_pool_create_internal(void) {
+    ArgArena* arena = argparse_arena_create_internal(ARGPARSE_INTERN_BLOCK_SIZE);
+    if (!arena) return NULL;
+
+    /* the pool header shares the first block with the strings */
+    ArgInternPool* pool = (ArgInternPool*)argparse_arena_calloc(arena, 1, sizeof(ArgInternPool));
+    ArgInternSlot* slots = (ArgInternSlot*)calloc(ARGPARSE_INTERN_MIN_CAPACITY,
+        sizeof(ArgInternSlot));
+
+    if (!pool || !slots) {
+        free(slots);
+        argparse_arena_destroy_internal(arena);
+        APE_SET_MEMORY(NULL);
+        return NULL;
+    }
+
+    pool->arena = arena;
+    pool->slots = slots;
+    pool->capacity = ARGPARSE_INTERN_MIN_CAPACITY;
+    return pool;
+}
+
+/* Doubles the slot array, reinserting by the cached hashes. */
+static bool intern_pool_grow(ArgInternPool* pool) {
+    if (pool->capacity > SIZE_MAX / 2 / sizeof(ArgInternSlot)) return false;
+
+    size_t capacity = pool->capacity * 2;
+    ArgInternSlot* slots = (ArgInternSlot*)calloc(capacity, sizeof(ArgInternSlot));
+    if (!slots) return false;
+
+    for (size_t i = 0; i < pool->capacity; i++) {
+        const ArgInternSlot* slot = &pool->slots[i];
+        if (!slot->str) continue;
+
+        size_t at = slot->hash & (capacity - 1);
+        while (slots[at].str) at = (at + 1) & (capacity - 1);
+        slots[at] = *slot;
+    }
+
+    free(pool->slots);
+    pool->slots = slots;
+    pool->capacity = capacity;
+    return true;
+}
+
+char* argparse_intern_internal(ArgInternPool* pool, const char* str) {
+    if (!str) return NULL;
+
+    size_t len;
+    uint32_t hash = argparse_hash_string_len_internal(str, ARGPARSE_HASH_FIXED_SEED, &len);
+    if (len > UINT32_MAX) return NULL;
+
+    size_t mask = pool->capacity - 1, at = hash & mask;
+
+    for (; pool->slots[at].str; at = (at + 1) & mask) {
+        const ArgInternSlot* slot = &pool->slots[at];
+
+        if (slot->hash == hash && slot->len == len && memcmp(slot->str, str, len) == 0)
+            return (char*)slot->str;
+    }
+
+    /* the copy goes in first, a failed grow only leaves it unreferenced */
+    char* copy = (char*)argparse_arena_malloc(pool->arena, len + 1);
+    if (!copy) return NULL;
+    memcpy(copy, str, len + 1);
+    ARGPARSE_STATS_ADD(bytes_copied, len + 1);
+
+    if ((pool->count + 1) * 4 > pool->capacity * 3) {
+        if (!intern_pool_grow(pool)) return NULL;
+
+        mask = pool->capacity - 1;
+        for (at = hash & mask; pool->slots[at].str; at = (at + 1) & mask) {}
+    }
+
+    pool->slots[at].str = copy;
+    pool->slots[at].hash = hash;
+    pool->slots[at].len = (uint32_t)len;
+    pool->count++;
+    return copy;
+}
+
+void argparse_intern_pool_destroy_internal(ArgInternPool* pool) {
+    if (!pool) return;
+
+    free(pool->slots);
+    argparse_arena_destroy_internal(pool->arena);
 }
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "argparse_number.h"
+#include <float.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(ARGPARSE_NUMBER_SSE2)
+#include <emmintrin.h>
+#elif defined(ARGPARSE_NUMBER_NEON)
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/* Clinger's fast path is exact only when double arithmetic is not carried out in wider registers. */
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+#define ARGPARSE_NUMBER_EXACT_DOUBLE 1
+#endif
+
+/* Largest mantissa that converts to double without rounding. */
+#define NUMBER_MAX_EXACT_MANTISSA (UINT64_C(1) << 53)
+
+/* Mantissa digits that always fit a uint64_t. */
+#define NUMBER_MAX_MANTISSA_DIGITS 19
+
+/* Every power of ten up to 1e22 is exactly representable. */
+#define NUMBER_MAX_EXACT_POW10 22
+
+static bool is_digit(char c) {
+    return (unsigned char)(c - '0') < 10;
+}
+
+#if defined(ARGPARSE_NUMBER_SSE2) || defined(ARGPARSE_NUMBER_NEON)
+/* Index of the lowest set bit; value must be non-zero. */
+static unsigned lowest_bit(uint64_t value) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return (unsigned)index;
+#else
+    unsigned index = 0;
+    while (!(value & 1U)) { value >>= 1; index++; }
+    return index;
+#endif
+}
+#endif
+
+size_t argparse_number_digit_run_internal(const char* str, size_t avail) {
+    size_t run = 0;
+
+#if defined(ARGPARSE_NUMBER_SSE2)
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+
+    /* 16 bytes per step: a byte is a digit iff min(byte - '0', 9) == byte - '0' */
+    while (avail - run >= 16) {
+        __m128i chunk = _mm_sub_epi8(_mm_loadu_si128((const __m128i*)(const void*)(str + run)), zero);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(chunk, nine), chunk));
+
+        if (mask != 0xFFFFU)
+            return run + lowest_bit(~mask & 0xFFFFU);
+        run += 16;
+    }
+#elif defined(ARGPARSE_NUMBER_NEON)
+    const uint8x16_t zero = vdupq_n_u8('0');
+    const uint8x16_t ten = vdupq_n_u8(10);
+
+    /* 16 bytes per step, narrowed to a 4-bit-per-byte mask */
+    while (avail - run >= 16) {
+        uint8x16_t chunk = vsubq_u8(vld1q_u8((const uint8_t*)(str + run)), zero);
+        uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(vcltq_u8(chunk, ten)), 4);
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+
+        if (mask != UINT64_MAX)
+            return run + (lowest_bit(~mask) >> 2);
+        run += 16;
+    }
+#else
+    /* 8 bytes per step: every byte is in 0x30..0x39 */
+    while (avail - run >= 8) {
+        uint64_t chunk;
+        memcpy(&chunk, str + run, sizeof(chunk));
+
+        if ((chunk & UINT64_C(0xF0F0F0F0F0F0F0F0)) != UINT64_C(0x3030303030303030) ||
+            ((chunk + UINT64_C(0x0606060606060606)) & UINT64_C(0xF0F0F0F0F0F0F0F0)) !=
+            UINT64_C(0x3030303030303030))
+            break;
+        run += 8;
+    }
+#endif
+
+    while (run < avail && is_digit(str[run]))
+        run++;
+
+    return run;
+}
+
+/* Accumulates a digit run known to hold at most NUMBER_MAX_MANTISSA_DIGITS digits. */
+static uint64_t digits_value(const char* str, size_t len, uint64_t value) {
+    for (size_t i = 0; i < len; i++)
+        value = value * 10 + (uint64_t)(str[i] - '0');
+    return value;
+}
+
+size_t argparse_number_parse_int_internal(const char* str, size_t avail, int* out) {
+    size_t pos = 0;
+    bool negative = false;
+
+    if (avail > 0 && (str[0] == '-' || str[0] == '+')) {
+        negative = str[0] == '-';
+        pos = 1;
+    }
+
+    size_t digits = argparse_number_digit_run_internal(str + pos, avail - pos);
+
+    /* more than ten digits cannot fit, leave the diagnosis to strtol */
+    if (digits == 0 || digits > 10)
+        return 0;
+
+    uint64_t value = digits_value(str + pos, digits, 0);
+    uint64_t limit = negative ? (uint64_t)INT_MAX + 1 : (uint64_t)INT_MAX;
+
+    if (value > limit)
+        return 0;
+
+    *out = negative ? (int)(-(int64_t)value) : (int)value;
+    return pos + digits;
+}
+
+size_t argparse_number_parse_double_internal(const char* str, size_t avail, double* out) {
+#if defined(ARGPARSE_NUMBER_EXACT_DOUBLE)
+    static const double pow10[NUMBER_MAX_EXACT_POW10 + 1] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    size_t pos = 0;
+    bool negative = false;
+
+    if (avail > 0 && (str[0] == '-' || str[0] == '+')) {
+        negative = str[0] == '-';
+        pos = 1;
+    }
+
+    /* mantissa: integer digits, then optional fraction digits */
+    size_t int_digits = argparse_number_digit_run_internal(str + pos, avail - pos);
+
+    if (int_digits > NUMBER_MAX_MANTISSA_DIGITS)
+        return 0;
+
+    uint64_t mantissa = digits_value(str + pos, int_digits, 0);
+    pos += int_digits;
+
+    size_t frac_digits = 0;
+
+    if (pos < avail && str[pos] == '.') {
+        frac_digits = argparse_number_digit_run_internal(str + pos + 1, avail - pos - 1);
+
+        if (int_digits + frac_digits > NUMBER_MAX_MANTISSA_DIGITS)
+            return 0;
+
+        mantissa = digits_value(str + pos + 1, frac_digits, mantissa);
+        pos += 1 + frac_digits;
+    }
+
+    if (int_digits + frac_digits == 0)
+        return 0;
+
+    /* optional exponent, at most three digits */
+    long exponent = 0;
+
+    if (pos < avail && (str[pos] == 'e' || str[pos] == 'E')) {
+        size_t exp_pos = pos + 1;
+        bool exp_negative = false;
+
+        if (exp_pos < avail && (str[exp_pos] == '-' || str[exp_pos] == '+')) {
+            exp_negative = str[exp_pos] == '-';
+            exp_pos++;
+        }
+
+        size_t exp_digits = argparse_number_digit_run_internal(str + exp_pos, avail - exp_pos);
+
+        if (exp_digits == 0 || exp_digits > 3)
+            return 0;
+
+        exponent = (long)digits_value(str + exp_pos, exp_digits, 0);
+        if (exp_negative) exponent = -exponent;
+        pos = exp_pos + exp_digits;
+    }
+
+    exponent -= (long)frac_digits;
+
+    double value;
+
+    if (mantissa == 0)
+        value = 0.0;
+    else if (mantissa > NUMBER_MAX_EXACT_MANTISSA ||
+        exponent < -NUMBER_MAX_EXACT_POW10 || exponent > NUMBER_MAX_EXACT_POW10)
+        return 0;
+    else if (exponent < 0)
+        value = (double)mantissa / pow10[-exponent];
+    else
+        value = (double)mantissa * pow10[exponent];
+
+    /* both operands are exact, so one IEEE operation rounds correctly */
+    *out = negative ? -value : value;
+    return pos;
+#else
+    (void)str;
+    (void)avail;
+    (void)out;
+    return 0;
+#endif
+}
@@ -0,0 +1,259 @@
+/* mmap() and friends are hidden by strict -std=c99. */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "argparse.h"
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#include <io.h>
+#define open _open
+#define read _read
+#define close _close
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+#if !defined(S_ISREG) && defined(S_IFMT)
+#define S_ISREG(mode) (((mode) & S_IFMT) == S_IFREG)
+#endif
+
+/* Upper bound on a single read() request, fits every platform's count type. */
+#define RESPONSE_READ_CHUNK (1U << 20)
+
+static bool is_word_space(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f' || c == '\0';
+}
+
+bool argparse_words_split_internal(char* data, size_t len, size_t* count) {
+    size_t r = 0, words = 0;
+    char* out = data;
+
+    /* words never grow and each consumed at least one separator, so out stays behind r */
+    while (r < len) {
+        while (r < len && is_word_space(data[r])) r++;
+        if (r == len) break;
+
+        char* word = out;
+        bool quoted = false;
+
+        while (r < len && !is_word_space(data[r])) {
+            char c = data[r++];
+
+            if (c == '\'') {
+                quoted = true;
+                while (r < len && data[r] != '\'') *out++ = data[r++];
+                if (r == len) goto unterminated;
+                r++;
+            }
+            else if (c == '"') {
+                quoted = true;
+                while (r < len && data[r] != '"') {
+                    if (data[r] == '\\' && r + 1 < len &&
+                        (data[r + 1] == '"' || data[r + 1] == '\\'))
+                        r++;
+                    *out++ = data[r++];
+                }
+                if (r == len) goto unterminated;
+                r++;
+            }
+            else if (c == '\\' && r < len) {
+                /* backslash-newline joins lines */
+                if (data[r] == '\n') r++;
+                else *out++ = data[r++];
+            }
+            else
+                *out++ = c;
+        }
+
+        /* the separator (or the spare byte at the end) makes room for the terminator */
+        r++;
+
+        /* a lone line continuation is not a word, an empty quote is */
+        if (out != word || quoted) {
+            *out++ = '\0';
+            words++;
+        }
+    }
+
+    *count = words;
+    return true;
+
+unterminated:
+    APE_SET(APE_SYNTAX, EINVAL, NULL, "Unterminated quote.");
+    return false;
+}
+
+/* Reads the rest of a descriptor into a heap buffer with one spare byte. */
+static bool read_all(int fd, size_t size_hint, ArgWords* words) {
+    size_t capacity = size_hint + 1, used = 0;
+    char* data = (char*)malloc(capacity);
+    if (!data) { errno = ENOMEM; return false; }
+
+    for (;;) {
+        if (capacity - used < 2) {
+            char* grown = capacity <= SIZE_MAX / 2 ? (char*)realloc(data, capacity * 2) : NULL;
+            if (!grown) { free(data); errno = ENOMEM; return false; }
+            data = grown;
+            capacity *= 2;
+        }
+
+        size_t want = capacity - used - 1;
+        if (want > RESPONSE_READ_CHUNK) want = RESPONSE_READ_CHUNK;
+
+        long got = (long)read(fd, data + used, (unsigned)want);
+        if (got < 0) {
+            if (errno == EINTR) continue;
+            free(data);
+            return false;
+        }
+        if (got == 0) break;
+        used += (size_t)got;
+    }
+
+    words->data = data;
+    words->size = used;
+    return true;
+}
+
+static bool is_line_space(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+bool argparse_words_split_config_internal(char* data, size_t len, size_t* count) {
+    size_t r = 0, words = 0;
+    char* out = data;
+
+    while (r < len) {
+        /* one line, without the newline and surrounding blanks */
+        size_t start = r;
+        while (r < len && data[r] != '\n') r++;
+        size_t end = r++;
+
+        while (start < end && is_line_space(data[start])) start++;
+        while (end > start && is_line_space(data[end - 1])) end--;
+
+        /* blank lines, comments and [section] headers carry no values */
+        if (start == end || data[start] == '#' || data[start] == ';' || data[start] == '[')
+            continue;
+
+        const char* equals = (const char*)memchr(data + start, '=', end - start);
+        if (!equals) continue;
+
+        size_t key_end = (size_t)(equals - data), value = key_end + 1;
+        while (key_end > start && is_line_space(data[key_end - 1])) key_end--;
+        while (value < end && is_line_space(data[value])) value++;
+
+        if (key_end == start) continue;
+
+        /* a quoted value keeps its inner blanks */
+        if (end - value >= 2 && (data[value] == '"' || data[value] == '\'') &&
+            data[end - 1] == data[value]) {
+            value++;
+            end--;
+        }
+
+        /* pairs only ever move towards the front: the line end makes room for both NULs */
+        memmove(out, data + start, key_end - start);
+        out += key_end - start;
+        *out++ = '\0';
+
+        memmove(out, data + value, end - value);
+        out += end - value;
+        *out++ = '\0';
+
+        words += 2;
+    }
+
+    *count = words;
+    return true;
+}
+
+ArgWords* argparse_file_load_internal(const char* path) {
+    ArgWords* words = (ArgWords*)calloc(1, sizeof(ArgWords));
+
+    if (!words) {
+        APE_SET_MEMORY(path);
+        return NULL;
+    }
+
+    int fd = open(path, O_RDONLY | O_BINARY);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        int saved = errno;
+        if (fd >= 0) close(fd);
+        free(words);
+        APE_SET(APE_VALIDATION, saved, path, "Cannot open file.");
+        return NULL;
+    }
+
+    size_t size = S_ISREG(st.st_mode) ? (size_t)st.st_size : 0;
+
+#ifndef _WIN32
+    /* the split needs one byte past the text: the zero fill of a partial last page */
+    long page = sysconf(_SC_PAGESIZE);
+
+    if (size >= ARGPARSE_RESPONSE_MMAP_MIN && page > 0 && size % (size_t)page != 0) {
+        void* map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+        if (map != MAP_FAILED) {
+            words->data = (char*)map;
+            words->size = size;
+            words->mapped = true;
+        }
+    }
+#endif
+
+    if (!words->mapped && !read_all(fd, size, words)) {
+        int saved = errno;
+        close(fd);
+        free(words);
+
+        if (saved == ENOMEM)
+            APE_SET_MEMORY(path);
+        else
+            APE_SET(APE_VALIDATION, saved, path, "Cannot read file.");
+        return NULL;
+    }
+
+    close(fd);
+    return words;
+}
+
+ArgWords* argparse_words_load_internal(const char* path) {
+    ArgWords* words = argparse_file_load_internal(path);
+
+    /* a private mapping is copy-on-write, splitting it leaves the file untouched */
+    if (words && !argparse_words_split_internal(words->data, words->size, &words->count)) {
+        argparse_words_free_internal(words);
+        return NULL;
+    }
+
+    return words;
+}
+
+void argparse_words_free_internal(ArgWords* words) {
+    while (words) {
+        ArgWords* next = words->next;
+
+#ifndef _WIN32
+        if (words->mapped)
+            munmap(words->data, words->size);
+        else
+#endif
+            free(words->data);
+
+        free(words);
+        words = next;
+    }
+}
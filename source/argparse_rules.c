@@ -0,0 +1,244 @@
+#include "argparse.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+/* Index of the lowest set bit; word must be non-zero. */
+static size_t lowest_bit(ArgBits word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctzll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (size_t)index;
+#else
+    size_t index = 0;
+    while (!(word & 1U)) { word >>= 1; index++; }
+    return index;
+#endif
+}
+
+static size_t bit_count(ArgBits word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_popcountll(word);
+#else
+    size_t count = 0;
+    for (; word; word &= word - 1) count++;
+    return count;
+#endif
+}
+
+bool argparse_bits_grow_internal(ArgArena* arena, ArgBits** bits, size_t words, size_t new_words) {
+    if (new_words <= words) return true;
+    if (new_words > SIZE_MAX / sizeof(ArgBits)) return false;
+
+    ArgBits* grown = (ArgBits*)argparse_arena_realloc(arena, *bits,
+        words * sizeof(ArgBits), new_words * sizeof(ArgBits));
+    if (!grown) return false;
+
+    memset(grown + words, 0, (new_words - words) * sizeof(ArgBits));
+    *bits = grown;
+    return true;
+}
+
+size_t argparse_bits_next_missing_internal(const ArgBits* wanted, const ArgBits* present,
+    size_t words, size_t from) {
+    size_t w = ARGPARSE_BIT_WORD(from);
+    if (w >= words) return ARGPARSE_BIT_NONE;
+
+    /* the first word drops the indices below from */
+    ArgBits missing = wanted[w] & ~present[w] & ~(ARGPARSE_BIT_MASK(from) - 1);
+
+    for (;;) {
+        if (missing) return w * ARGPARSE_BITS_PER_WORD + lowest_bit(missing);
+        if (++w == words) return ARGPARSE_BIT_NONE;
+        missing = wanted[w] & ~present[w];
+    }
+}
+
+size_t argparse_bits_first_common_internal(const ArgBits* a, const ArgBits* b, size_t words,
+    size_t from) {
+    size_t w = ARGPARSE_BIT_WORD(from);
+    if (w >= words) return ARGPARSE_BIT_NONE;
+
+    /* the first word drops the indices below from */
+    ArgBits common = a[w] & b[w] & ~(ARGPARSE_BIT_MASK(from) - 1);
+
+    for (;;) {
+        if (common) return w * ARGPARSE_BITS_PER_WORD + lowest_bit(common);
+        if (++w == words) return ARGPARSE_BIT_NONE;
+        common = a[w] & b[w];
+    }
+}
+
+size_t argparse_bits_count_common_internal(const ArgBits* a, const ArgBits* b, size_t words) {
+    size_t count = 0;
+
+    for (size_t w = 0; w < words; w++)
+        count += bit_count(a[w] & b[w]);
+
+    return count;
+}
+
+static void assign_bit(ArgBits* bits, size_t index, bool value) {
+    if (value) bits[ARGPARSE_BIT_WORD(index)] |= ARGPARSE_BIT_MASK(index);
+    else bits[ARGPARSE_BIT_WORD(index)] &= ~ARGPARSE_BIT_MASK(index);
+}
+
+bool argparse_rules_index_internal(ArgParser* parser, size_t index, bool required, bool eager) {
+    size_t words = ARGPARSE_BIT_WORD(index) + 1;
+
+    /* all three grow together, a failure leaves bit_words at the size they all have */
+    if (words > parser->bit_words) {
+        ArgArena* arena = parser->arena;
+        size_t old = parser->bit_words;
+
+        if (!argparse_bits_grow_internal(arena, &parser->set_bits, old, words) ||
+            !argparse_bits_grow_internal(arena, &parser->required_bits, old, words) ||
+            !argparse_bits_grow_internal(arena, &parser->eager_bits, old, words))
+            return false;
+
+        parser->bit_words = words;
+    }
+
+    /* the index may be reused after a failed addition */
+    assign_bit(parser->set_bits, index, false);
+    assign_bit(parser->required_bits, index, required);
+    assign_bit(parser->eager_bits, index, required || eager);
+    return true;
+}
+
+/* Looks up a rule member, reporting names that are not registered. */
+static Argument* rule_argument(ArgParser* parser, const char* name) {
+    Argument* arg = name ? argparse_hash_find_argument(parser, name) : NULL;
+
+    if (!arg)
+        APE_SET(APE_CONFIG, EINVAL, name, "Rule names an unknown argument.");
+
+    return arg;
+}
+
+/* Adds one index to a rule bitset, growing it as needed. */
+static bool rule_add_bit(ArgParser* parser, ArgBits** bits, size_t* words, size_t index) {
+    size_t needed = ARGPARSE_BIT_WORD(index) + 1;
+
+    if (!argparse_bits_grow_internal(parser->arena, bits, *words, needed))
+        return false;
+
+    if (needed > *words) *words = needed;
+    assign_bit(*bits, index, true);
+
+    /* rule members are checked after every parse, fallbacks included */
+    parser->eager_bits[ARGPARSE_BIT_WORD(index)] |= ARGPARSE_BIT_MASK(index);
+    return true;
+}
+
+bool argparse_add_exclusive_group(ArgParser* parser, const char* const* names, size_t count,
+    bool required) {
+    argparse_error_clear();
+
+    if (!parser || !names || count == 0 || parser->overlay) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser or group names.");
+        return false;
+    }
+
+    /* resolve every name first, an unknown one leaves the parser unchanged */
+    for (size_t i = 0; i < count; i++) {
+        if (!rule_argument(parser, names[i]))
+            return false;
+    }
+
+    ArgGroup* group = (ArgGroup*)argparse_arena_calloc(parser->arena, 1, sizeof(ArgGroup));
+    if (!group) goto memory_error;
+
+    for (size_t i = 0; i < count; i++) {
+        Argument* arg = argparse_hash_find_argument(parser, names[i]);
+
+        if (!rule_add_bit(parser, &group->members, &group->words, arg->index)) {
+            argparse_arena_free(parser->arena, group->members);
+            argparse_arena_free(parser->arena, group);
+            goto memory_error;
+        }
+    }
+
+    group->required = required;
+    group->next = parser->groups;
+    parser->groups = group;
+    return true;
+
+memory_error:
+    APE_SET_MEMORY(names[0]);
+    return false;
+}
+
+bool argparse_add_dependency(ArgParser* parser, const char* name, const char* required_name) {
+    argparse_error_clear();
+
+    if (!parser || parser->overlay) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Parser is NULL.");
+        return false;
+    }
+
+    Argument* arg = rule_argument(parser, name);
+    if (!arg) return false;
+
+    Argument* needed = rule_argument(parser, required_name);
+    if (!needed) return false;
+
+    if (needed == arg) {
+        APE_SET(APE_CONFIG, EINVAL, name, "Argument cannot require itself.");
+        return false;
+    }
+
+    /* all requirements of one argument share an entry */
+    ArgDependency* dep = parser->dependencies;
+    while (dep && dep->index != arg->index) dep = dep->next;
+
+    bool created = !dep;
+
+    if (created) {
+        dep = (ArgDependency*)argparse_arena_calloc(parser->arena, 1, sizeof(ArgDependency));
+        if (!dep) goto memory_error;
+        dep->index = arg->index;
+    }
+
+    if (!rule_add_bit(parser, &dep->needs, &dep->words, needed->index)) {
+        if (created) argparse_arena_free(parser->arena, dep);
+        goto memory_error;
+    }
+
+    /* the dependent itself may come from a fallback too */
+    parser->eager_bits[ARGPARSE_BIT_WORD(arg->index)] |= ARGPARSE_BIT_MASK(arg->index);
+
+    if (created) {
+        dep->next = parser->dependencies;
+        parser->dependencies = dep;
+    }
+
+    return true;
+
+memory_error:
+    APE_SET_MEMORY(name);
+    return false;
+}
+
+void argparse_rules_free_internal(ArgParser* parser) {
+    for (ArgGroup* group = parser->groups, *next; group; group = next) {
+        next = group->next;
+        free(group->members);
+        free(group);
+    }
+
+    for (ArgDependency* dep = parser->dependencies, *next; dep; dep = next) {
+        next = dep->next;
+        free(dep->needs);
+        free(dep);
+    }
+
+    free(parser->set_bits);
+    free(parser->required_bits);
+    free(parser->eager_bits);
+}
@@ -0,0 +1,311 @@
+#include "argparse.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Appends blob sections; with no base it only measures, so layout and writing share one path. */
+typedef struct SchemaWriter {
+    unsigned char* base;    /* Destination, NULL while measuring */
+    size_t size;            /* Bytes laid out so far */
+} SchemaWriter;
+
+/* Reserves (and fills, when data is given) an aligned section; returns its offset. */
+static size_t schema_put(SchemaWriter* writer, const void* data, size_t length, size_t align) {
+    size_t offset = (writer->size + align - 1) & ~(align - 1);
+
+    if (writer->base) {
+        memset(writer->base + writer->size, 0, offset - writer->size);
+        if (data) memcpy(writer->base + offset, data, length);
+    }
+
+    writer->size = offset + length;
+    return offset;
+}
+
+static uint32_t schema_put_string(SchemaWriter* writer, const char* str) {
+    return str ? (uint32_t)schema_put(writer, str, strlen(str) + 1, 1) : 0;
+}
+
+static uint32_t schema_put_default(SchemaWriter* writer, const Argument* arg) {
+    if (!arg->value || arg->is_list) return 0;
+
+    switch (arg->type) {
+    case ARG_INT: return (uint32_t)schema_put(writer, arg->value, sizeof(int), 8);
+    case ARG_DOUBLE: return (uint32_t)schema_put(writer, arg->value, sizeof(double), 8);
+    case ARG_BOOL: return (uint32_t)schema_put(writer, arg->value, sizeof(bool), 8);
+    case ARG_STRING: return schema_put_string(writer, (const char*)arg->value);
+    default: return 0;
+    }
+}
+
+/* The implicit help argument is recreated on load. */
+static bool is_implicit_help(const Argument* arg) {
+    return arg->short_name && arg->long_name &&
+        strcmp(arg->short_name, "-h") == 0 && strcmp(arg->long_name, "--help") == 0;
+}
+
+static void schema_write(SchemaWriter* writer, ArgParser* parser, const Argument* const* args,
+    size_t count, const ArgSpecIndex* index) {
+    ArgSchemaHeader header;
+    memset(&header, 0, sizeof(header));
+
+    schema_put(writer, NULL, sizeof(header), 8);
+    size_t records = schema_put(writer, NULL, count * sizeof(ArgSchemaRecord), 8);
+
+    header.pilots = (uint32_t)schema_put(writer, index->pilots,
+        ((size_t)index->bucket_mask + 1) * sizeof(uint16_t), 8);
+    header.slots = (uint32_t)schema_put(writer, index->slots,
+        ((size_t)index->slot_mask + 1) * sizeof(uint32_t), 8);
+
+    for (size_t i = 0; i < count; i++) {
+        const Argument* arg = args[i];
+        ArgSchemaRecord record;
+        memset(&record, 0, sizeof(record));
+
+        record.default_value = schema_put_default(writer, arg);
+        record.short_name = schema_put_string(writer, arg->short_name);
+        record.long_name = schema_put_string(writer, arg->long_name);
+        record.help = schema_put_string(writer, arg->help);
+        record.type = (uint8_t)arg->type;
+        record.required = arg->required ? 1 : 0;
+        record.suffix = arg->suffix;
+        record.delimiter = arg->delimiter;
+
+        if (writer->base)
+            memcpy(writer->base + records + i * sizeof(record), &record, sizeof(record));
+    }
+
+    header.description = schema_put_string(writer, parser->description);
+
+    header.magic = ARGPARSE_SCHEMA_MAGIC;
+    header.version = ARGPARSE_SCHEMA_VERSION;
+    header.index_version = index->version;
+    header.size = (uint32_t)writer->size;
+    header.count = (uint32_t)count;
+    header.records = (uint32_t)records;
+    header.seed = index->seed;
+    header.bucket_mask = index->bucket_mask;
+    header.slot_mask = index->slot_mask;
+
+    if (writer->base)
+        memcpy(writer->base, &header, sizeof(header));
+}
+
+size_t argparse_save_schema(ArgParser* parser, void* buf, size_t len) {
+    argparse_error_clear();
+
+    if (!parser || (!buf && len > 0) || ((uintptr_t)buf & 7U)) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Invalid parser or buffer.");
+        return 0;
+    }
+
+    /* the blob holds arguments only, parser-level rules would be lost on load */
+    if (parser->groups || parser->dependencies) {
+        APE_SET(APE_CONFIG, EINVAL, NULL, "Exclusive groups and dependencies cannot be saved.");
+        return 0;
+    }
+
+    if (parser->subcommands) {
+        APE_SET(APE_CONFIG, EINVAL, NULL, "Subcommands cannot be saved.");
+        return 0;
+    }
+
+    if (parser->sources || parser->flags) {
+        APE_SET(APE_CONFIG, EINVAL, NULL, "Fallback sources and parser flags cannot be saved.");
+        return 0;
+    }
+
+    size_t count = 0;
+
+    for (const Argument* arg = parser->arguments; arg; arg = arg->next) {
+        if (is_implicit_help(arg)) continue;
+
+        /* caller pointers cannot be stored in a file */
+        if (arg->target || arg->callback) {
+            APE_SET(APE_CONFIG, EINVAL, arg->long_name ? arg->long_name : arg->short_name,
+                "Bound or streaming arguments cannot be saved.");
+            return 0;
+        }
+        count++;
+    }
+
+    const Argument** args = (const Argument**)malloc((count ? count : 1) * sizeof(Argument*));
+    ArgSpec* specs = (ArgSpec*)calloc(count ? count : 1, sizeof(ArgSpec));
+
+    if (!args || !specs) {
+        free(args);
+        free(specs);
+        APE_SET_MEMORY(NULL);
+        return 0;
+    }
+
+    count = 0;
+
+    for (const Argument* arg = parser->arguments; arg; arg = arg->next) {
+        if (is_implicit_help(arg)) continue;
+
+        specs[count].short_name = arg->short_name;
+        specs[count].long_name = arg->long_name;
+        args[count++] = arg;
+    }
+
+    /* a spec parser without later additions already has the right index */
+    const ArgSpecIndex* index = parser->spec_index;
+    ArgSpecIndex* built = NULL;
+
+    if (!index || parser->spec_tail->next || index->spec_count != count)
+        index = built = argparse_spec_index_create(specs, count);
+
+    size_t size = 0;
+
+    if (index) {
+        SchemaWriter writer = { NULL, 0 };
+        schema_write(&writer, parser, args, count, index);
+        size = writer.size;
+
+        if (size > UINT32_MAX) {
+            APE_SET_RANGE(NULL, "Schema too large.");
+            size = 0;
+        }
+        else if (size <= len) {
+            writer.base = (unsigned char*)buf;
+            writer.size = 0;
+            schema_write(&writer, parser, args, count, index);
+        }
+    }
+
+    argparse_spec_index_free(built);
+    free(args);
+    free(specs);
+    return size;
+}
+
+/* A string offset is valid when a terminator follows inside the blob. */
+static bool schema_string_ok(const unsigned char* blob, size_t size, uint32_t offset) {
+    return offset == 0 || (offset < size && memchr(blob + offset, '\0', size - offset));
+}
+
+static bool schema_section_ok(size_t size, uint32_t offset, size_t length, size_t align) {
+    return offset % align == 0 && offset <= size && length <= size - offset;
+}
+
+static const char* schema_string(const unsigned char* blob, uint32_t offset) {
+    return offset ? (const char*)(blob + offset) : NULL;
+}
+
+/* Checks every offset once so later lookups can trust the blob. */
+static bool schema_validate(const unsigned char* blob, size_t size) {
+    const ArgSchemaHeader* header = (const ArgSchemaHeader*)(const void*)blob;
+
+    if (size < sizeof(*header) || header->magic != ARGPARSE_SCHEMA_MAGIC ||
+        header->version != ARGPARSE_SCHEMA_VERSION ||
+        header->index_version != ARGPARSE_SPEC_INDEX_VERSION ||
+        header->size > size || header->count >= (UINT32_MAX / 2) - 2)
+        return false;
+
+    size = header->size;
+
+    size_t bucket_count = (size_t)header->bucket_mask + 1;
+    size_t slot_count = (size_t)header->slot_mask + 1;
+
+    if ((bucket_count & header->bucket_mask) || (slot_count & header->slot_mask) ||
+        !schema_section_ok(size, header->records,
+            (size_t)header->count * sizeof(ArgSchemaRecord), 8) ||
+        !schema_section_ok(size, header->pilots, bucket_count * sizeof(uint16_t), 8) ||
+        !schema_section_ok(size, header->slots, slot_count * sizeof(uint32_t), 8) ||
+        !schema_string_ok(blob, size, header->description))
+        return false;
+
+    /* slots name spec arguments, the help pair included */
+    const uint32_t* slots = (const uint32_t*)(const void*)(blob + header->slots);
+    uint32_t max_entry = 2 * (header->count + 1);
+
+    for (size_t i = 0; i < slot_count; i++) {
+        if (slots[i] > max_entry) return false;
+    }
+
+    const ArgSchemaRecord* records = (const ArgSchemaRecord*)(const void*)(blob + header->records);
+
+    for (uint32_t i = 0; i < header->count; i++) {
+        const ArgSchemaRecord* record = &records[i];
+
+        if (record->type > ARG_STRING_LIST ||
+            !schema_string_ok(blob, size, record->short_name) ||
+            !schema_string_ok(blob, size, record->long_name) ||
+            !schema_string_ok(blob, size, record->help))
+            return false;
+
+        if (record->default_value == 0) continue;
+
+        bool valid;
+
+        switch ((ArgType)record->type) {
+        case ARG_INT: valid = schema_section_ok(size, record->default_value, sizeof(int), 8); break;
+        case ARG_DOUBLE: valid = schema_section_ok(size, record->default_value, sizeof(double), 8); break;
+        case ARG_BOOL: valid = schema_section_ok(size, record->default_value, sizeof(bool), 8); break;
+        case ARG_STRING: valid = schema_string_ok(blob, size, record->default_value); break;
+        default: valid = false; break;
+        }
+
+        if (!valid) return false;
+    }
+
+    return true;
+}
+
+ArgParser* argparse_load_schema(const void* blob, size_t size) {
+    argparse_error_clear();
+
+    const unsigned char* bytes = (const unsigned char*)blob;
+
+    if (!bytes || ((uintptr_t)bytes & 7U) || !schema_validate(bytes, size)) {
+        APE_SET(APE_CONFIG, EINVAL, NULL, "Invalid or outdated schema blob.");
+        return NULL;
+    }
+
+    const ArgSchemaHeader* header = (const ArgSchemaHeader*)blob;
+    const ArgSchemaRecord* records = (const ArgSchemaRecord*)(const void*)(bytes + header->records);
+
+    /* the table only lives through construction, names and help stay in the blob */
+    ArgSpec* specs = (ArgSpec*)calloc(header->count ? header->count : 1, sizeof(ArgSpec));
+    ArgSpecIndex* index = (ArgSpecIndex*)malloc(sizeof(ArgSpecIndex));
+
+    if (!specs || !index) {
+        free(specs);
+        free(index);
+        APE_SET_MEMORY(NULL);
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < header->count; i++) {
+        specs[i].short_name = schema_string(bytes, records[i].short_name);
+        specs[i].long_name = schema_string(bytes, records[i].long_name);
+        specs[i].help = schema_string(bytes, records[i].help);
+        specs[i].type = (ArgType)records[i].type;
+        specs[i].required = records[i].required != 0;
+        specs[i].default_value = records[i].default_value ? bytes + records[i].default_value : NULL;
+        specs[i].suffix = (char)records[i].suffix;
+        specs[i].delimiter = (char)records[i].delimiter;
+    }
+
+    /* the perfect hash is used in place */
+    index->version = header->index_version;
+    index->spec_count = header->count;
+    index->seed = header->seed;
+    index->bucket_mask = header->bucket_mask;
+    index->slot_mask = header->slot_mask;
+    index->pilots = (const uint16_t*)(const void*)(bytes + header->pilots);
+    index->slots = (const uint32_t*)(const void*)(bytes + header->slots);
+
+    ArgParser* parser = argparse_new_from_spec(schema_string(bytes, header->description),
+        specs, header->count, index);
+    free(specs);
+
+    if (!parser) {
+        free(index);
+        return NULL;
+    }
+
+    /* released by argparse_free(), the arrays it points to belong to the blob */
+    parser->owned_spec_index = index;
+    return parser;
+}
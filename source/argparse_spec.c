@@ -0,0 +1,301 @@
+#include "argparse.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Upper bounds on the generator search; both are far above what real tables need. */
+#define SPEC_MAX_SEED_ATTEMPTS 64
+#define SPEC_MAX_PILOT 0xFFFFU
+
+static uint32_t next_power_of_two(uint32_t value) {
+    uint32_t result = 1;
+    while (result < value) result <<= 1;
+    return result;
+}
+
+/* Final slot for a name: the bucket pilot perturbs a bijective 32-bit mixer. */
+static uint32_t spec_slot(uint32_t hash, uint32_t pilot, uint32_t slot_mask) {
+    uint32_t x = hash ^ (pilot * 0x9E3779B9U);
+
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+
+    return x & slot_mask;
+}
+
+/* Name behind a name id, including the implicit help argument at index count. */
+static const char* spec_name(const ArgSpec* specs, size_t count, uint32_t id) {
+    size_t i = id >> 1;
+
+    if (i == count)
+        return (id & 1U) ? "--help" : "-h";
+
+    return (id & 1U) ? specs[i].long_name : specs[i].short_name;
+}
+
+/* Scratch state shared by the seed attempts of one index build. */
+typedef struct SpecBuild {
+    uint32_t* ids;          /* Name id per key */
+    uint32_t* hashes;       /* Seeded hash per key */
+    uint32_t* bucket_start; /* CSR offsets into members, bucket_count + 1 entries */
+    uint32_t* members;      /* Keys grouped by bucket */
+    uint32_t* order;        /* Buckets sorted by decreasing size */
+    bool* taken;            /* Slot occupancy */
+    uint32_t key_count;
+    uint32_t bucket_count;
+    uint32_t slot_count;
+} SpecBuild;
+
+/* Returns 1 on success, 0 to retry with another seed, -1 on duplicate names. */
+static int spec_try_seed(SpecBuild* build, const ArgSpec* specs, size_t count,
+    uint32_t seed, uint16_t* pilots, uint32_t* slots) {
+    const uint32_t bucket_mask = build->bucket_count - 1;
+    const uint32_t slot_mask = build->slot_count - 1;
+
+    for (uint32_t k = 0; k < build->key_count; k++)
+        build->hashes[k] = argparse_hash_string_internal(
+            spec_name(specs, count, build->ids[k]), seed);
+
+    /* group keys by bucket (counting sort) */
+    memset(build->bucket_start, 0, (build->bucket_count + 1) * sizeof(uint32_t));
+
+    for (uint32_t k = 0; k < build->key_count; k++)
+        build->bucket_start[(build->hashes[k] & bucket_mask) + 1]++;
+
+    for (uint32_t b = 0; b < build->bucket_count; b++)
+        build->bucket_start[b + 1] += build->bucket_start[b];
+
+    for (uint32_t k = 0; k < build->key_count; k++) {
+        uint32_t b = build->hashes[k] & bucket_mask;
+        uint32_t pos = build->bucket_start[b];
+
+        /* place, then shift the start forward; restored below */
+        build->members[pos] = k;
+        build->bucket_start[b]++;
+    }
+
+    for (uint32_t b = build->bucket_count; b > 0; b--)
+        build->bucket_start[b] = build->bucket_start[b - 1];
+    build->bucket_start[0] = 0;
+
+    /* identical full hashes can never be separated by a pilot */
+    for (uint32_t b = 0; b < build->bucket_count; b++) {
+        for (uint32_t i = build->bucket_start[b]; i < build->bucket_start[b + 1]; i++) {
+            for (uint32_t j = i + 1; j < build->bucket_start[b + 1]; j++) {
+                uint32_t ki = build->members[i], kj = build->members[j];
+
+                if (build->hashes[ki] != build->hashes[kj])
+                    continue;
+
+                if (strcmp(spec_name(specs, count, build->ids[ki]),
+                    spec_name(specs, count, build->ids[kj])) == 0)
+                    return -1;
+                return 0;
+            }
+        }
+    }
+
+    /* largest buckets first, they are hardest to place */
+    uint32_t max_size = 0;
+    for (uint32_t b = 0; b < build->bucket_count; b++) {
+        uint32_t size = build->bucket_start[b + 1] - build->bucket_start[b];
+        if (size > max_size) max_size = size;
+    }
+
+    uint32_t ordered = 0;
+    for (uint32_t size = max_size; size > 0; size--) {
+        for (uint32_t b = 0; b < build->bucket_count; b++) {
+            if (build->bucket_start[b + 1] - build->bucket_start[b] == size)
+                build->order[ordered++] = b;
+        }
+    }
+
+    memset(build->taken, 0, build->slot_count * sizeof(bool));
+    memset(pilots, 0, build->bucket_count * sizeof(uint16_t));
+    memset(slots, 0, build->slot_count * sizeof(uint32_t));
+
+    for (uint32_t o = 0; o < ordered; o++) {
+        uint32_t b = build->order[o];
+        uint32_t first = build->bucket_start[b], last = build->bucket_start[b + 1];
+        bool placed = false;
+
+        for (uint32_t pilot = 0; pilot <= SPEC_MAX_PILOT && !placed; pilot++) {
+            uint32_t i = first;
+
+            /* claim slots one by one, rolling back on the first conflict */
+            for (; i < last; i++) {
+                uint32_t slot = spec_slot(build->hashes[build->members[i]], pilot, slot_mask);
+                if (build->taken[slot]) break;
+                build->taken[slot] = true;
+            }
+
+            if (i == last) {
+                pilots[b] = (uint16_t)pilot;
+                placed = true;
+                break;
+            }
+
+            while (i > first) {
+                i--;
+                build->taken[spec_slot(build->hashes[build->members[i]], pilot, slot_mask)] = false;
+            }
+        }
+
+        if (!placed) return 0;
+    }
+
+    for (uint32_t k = 0; k < build->key_count; k++) {
+        uint32_t b = build->hashes[k] & bucket_mask;
+        slots[spec_slot(build->hashes[k], pilots[b], slot_mask)] = build->ids[k] + 1;
+    }
+
+    return 1;
+}
+
+ArgSpecIndex* argparse_spec_index_create(const ArgSpec* specs, size_t count) {
+    /* clear previous error */
+    argparse_error_clear();
+
+    if (!specs && count > 0) {
+        APE_SET(APE_INTERNAL, EINVAL, NULL, "Spec table is NULL.");
+        return NULL;
+    }
+
+    /* two names per entry plus the help pair must fit a 32-bit id */
+    if (count >= (UINT32_MAX / 2) - 2) {
+        APE_SET_RANGE(NULL, "Spec table too large.");
+        return NULL;
+    }
+
+    SpecBuild build;
+    memset(&build, 0, sizeof(build));
+
+    size_t max_keys = 2 * (count + 1);
+    build.ids = (uint32_t*)malloc(max_keys * sizeof(uint32_t));
+
+    if (!build.ids) {
+        APE_SET_MEMORY(NULL);
+        return NULL;
+    }
+
+    /* collect every present name */
+    for (uint32_t id = 0; id < (uint32_t)max_keys; id++) {
+        const char* name = spec_name(specs, count, id);
+        if (name && name[0] != '\0')
+            build.ids[build.key_count++] = id;
+    }
+
+    build.bucket_count = next_power_of_two((build.key_count + 1) / 2);
+    build.slot_count = next_power_of_two(build.key_count) * 2;
+
+    /* one block: header, slots, then pilots */
+    size_t slots_size = build.slot_count * sizeof(uint32_t);
+    size_t pilots_size = build.bucket_count * sizeof(uint16_t);
+    ArgSpecIndex* index = (ArgSpecIndex*)malloc(sizeof(ArgSpecIndex) + slots_size + pilots_size);
+
+    build.hashes = (uint32_t*)malloc(build.key_count * sizeof(uint32_t) + 1);
+    build.members = (uint32_t*)malloc(build.key_count * sizeof(uint32_t) + 1);
+    build.bucket_start = (uint32_t*)malloc((build.bucket_count + 1) * sizeof(uint32_t));
+    build.order = (uint32_t*)malloc(build.bucket_count * sizeof(uint32_t));
+    build.taken = (bool*)malloc(build.slot_count * sizeof(bool));
+
+    if (!index || !build.hashes || !build.members || !build.bucket_start ||
+        !build.order || !build.taken) {
+        APE_SET_MEMORY(NULL);
+        free(index);
+        index = NULL;
+        goto cleanup;
+    }
+
+    uint32_t* slots = (uint32_t*)(index + 1);
+    uint16_t* pilots = (uint16_t*)((unsigned char*)slots + slots_size);
+
+    /* deterministic seed sequence: generated tables are reproducible */
+    uint32_t seed = 0x5EED1234U;
+    int result = 0;
+
+    for (int attempt = 0; attempt < SPEC_MAX_SEED_ATTEMPTS && result == 0; attempt++) {
+        result = spec_try_seed(&build, specs, count, seed, pilots, slots);
+        if (result == 0) seed = seed * 1664525U + 1013904223U;
+    }
+
+    if (result != 1) {
+        if (result < 0)
+            APE_SET_DUPLICATE(NULL);
+        else
+            APE_SET(APE_INTERNAL, EINVAL, NULL, "No perfect hash found for spec table.");
+        free(index);
+        index = NULL;
+        goto cleanup;
+    }
+
+    index->version = ARGPARSE_SPEC_INDEX_VERSION;
+    index->spec_count = (uint32_t)count;
+    index->seed = seed;
+    index->bucket_mask = build.bucket_count - 1;
+    index->slot_mask = build.slot_count - 1;
+    index->pilots = pilots;
+    index->slots = slots;
+
+cleanup:
+    free(build.ids);
+    free(build.hashes);
+    free(build.members);
+    free(build.bucket_start);
+    free(build.order);
+    free(build.taken);
+    return index;
+}
+
+void argparse_spec_index_free(ArgSpecIndex* index) {
+    free(index);
+}
+
+bool argparse_spec_index_write(FILE* out, const ArgSpecIndex* index, const char* symbol) {
+    if (!out || !index || !symbol || symbol[0] == '\0')
+        return false;
+
+    fprintf(out, "/* Generated by argparse_spec_index_write(); "
+        "regenerate whenever the spec table changes. */\n");
+
+    fprintf(out, "static const uint16_t %s_pilots[%lu] = {", symbol,
+        (unsigned long)index->bucket_mask + 1);
+
+    for (uint32_t b = 0; b <= index->bucket_mask; b++)
+        fprintf(out, "%s%u,", (b % 12 == 0) ? "\n    " : " ", index->pilots[b]);
+
+    fprintf(out, "\n};\n\nstatic const uint32_t %s_slots[%lu] = {", symbol,
+        (unsigned long)index->slot_mask + 1);
+
+    for (uint32_t s = 0; s <= index->slot_mask; s++)
+        fprintf(out, "%s%u,", (s % 12 == 0) ? "\n    " : " ", index->slots[s]);
+
+    fprintf(out, "\n};\n\nstatic const ArgSpecIndex %s = {\n"
+        "    %uU, %uU, 0x%08XU, %uU, %uU, %s_pilots, %s_slots\n};\n",
+        symbol, index->version, index->spec_count, index->seed,
+        index->bucket_mask, index->slot_mask, symbol, symbol);
+
+    return !ferror(out);
+}
+
+Argument* argparse_spec_lookup_internal(const ArgParser* parser, const char* name, size_t len) {
+    const ArgSpecIndex* index = parser->spec_index;
+    uint32_t hash = argparse_hash_bytes_internal(name, len, index->seed);
+
+    uint32_t pilot = index->pilots[hash & index->bucket_mask];
+    uint32_t entry = index->slots[spec_slot(hash, pilot, index->slot_mask)];
+
+    if (entry == ARGPARSE_SPEC_EMPTY_SLOT)
+        return NULL;
+
+    /* the slot proves nothing for unknown names, confirm with one compare */
+    uint32_t id = entry - 1;
+    Argument* arg = &parser->spec_arguments[id >> 1];
+    const char* candidate = (id & 1U) ? arg->long_name : arg->short_name;
+    ARGPARSE_STATS_ADD(string_compares, 1);
+
+    return (candidate && strncmp(candidate, name, len) == 0 &&
+        candidate[len] == '\0') ? arg : NULL;
+}
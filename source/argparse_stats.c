@@ -0,0 +1,90 @@
+/* clock_gettime() is hidden by strict -std=c99. */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "argparse.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ARGPARSE_STATS
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+/* -std=c99 has no _Thread_local, GCC and Clang still offer __thread */
+#define THREAD_LOCAL __thread
+#else
+#define THREAD_LOCAL _Thread_local
+#endif
+
+/* Statistics of the parse running on this thread, counters elsewhere only test it. */
+static THREAD_LOCAL ArgParseStats* g_active_stats = NULL;
+
+ArgParseStats* argparse_stats_active_internal(void) {
+    return g_active_stats;
+}
+
+unsigned long long argparse_stats_now_internal(void) {
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (unsigned long long)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+ArgParseStats* argparse_stats_enter_internal(ArgParser* parser) {
+    ArgParseStats* previous = g_active_stats;
+
+    /* result views share the schema, counting into it would race between threads */
+    if (parser->overlay) {
+        g_active_stats = NULL;
+        return previous;
+    }
+
+    /* created on the first parse, a failure only leaves this parse uncounted */
+    if (!parser->stats)
+        parser->stats = (ArgParseStats*)argparse_arena_calloc(parser->arena, 1, sizeof(ArgParseStats));
+
+    g_active_stats = parser->stats;
+    return previous;
+}
+
+void argparse_stats_leave_internal(ArgParseStats* previous) {
+    g_active_stats = previous;
+}
+
+#else
+
+ArgParseStats* argparse_stats_enter_internal(ArgParser* parser) {
+    (void)parser;
+    return NULL;
+}
+
+void argparse_stats_leave_internal(ArgParseStats* previous) {
+    (void)previous;
+}
+
+#endif
+
+const ArgParseStats* argparse_get_stats(const ArgParser* parser) {
+    return parser ? parser->stats : NULL;
+}
+
+void argparse_reset_stats(ArgParser* parser) {
+    if (parser && parser->stats)
+        memset(parser->stats, 0, sizeof(*parser->stats));
+}
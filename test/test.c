@@ -0,0 +1,1081 @@
+/* Regression tests for argparse, run with `make test` (built with ASan and UBSan). */
+
+/* setenv() is hidden by strict -std=c99. */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "argparse.h"
+#include "argparse_number.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Scratch files are created in the working directory and removed again. */
+#define TEST_RESPONSE_FILE "argparse_test.rsp"
+#define TEST_CONFIG_FILE "argparse_test.ini"
+
+/* Environment source prefix, variables are removed after each test. */
+#define TEST_ENV_PREFIX "ARGPARSE_TEST_"
+
+#ifdef _WIN32
+#define setenv(name, value, overwrite) _putenv_s(name, value)
+#define unsetenv(name) _putenv_s(name, "")
+#endif
+
+static int g_failures = 0;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            g_failures++; \
+        } \
+    } while (0)
+
+typedef struct Test {
+    const char* name;
+    void (*run)(void);
+} Test;
+
+static void write_file(const char* path, const char* text) {
+    FILE* file = fopen(path, "w");
+
+    if (!file) {
+        fprintf(stderr, "cannot create %s\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    fputs(text, file);
+    fclose(file);
+}
+
+/* The arguments most tests share, on the heap or in an arena. */
+static ArgParser* sample_parser(bool arena) {
+    int round = 7;
+    ArgParser* parser = arena ? argparse_new_with_arena("test") : argparse_new("test");
+
+    argparse_add_argument(parser, "-r", "--round", ARG_INT, "Rounds", false, &round);
+    argparse_add_argument(parser, "-d", "--ratio", ARG_DOUBLE, "Ratio", false, NULL);
+    argparse_add_argument(parser, "-s", "--name", ARG_STRING, "Name", false, NULL);
+    argparse_add_argument(parser, "-v", "--verbose", ARG_BOOL, "Verbose", false, NULL);
+    argparse_add_list_argument(parser, "-n", "--numbers", ARG_INT_LIST, "Numbers", false);
+    argparse_add_list_argument_ex(parser, "-f", "--files", ARG_STRING_LIST, "Files", false, '=', ',');
+    argparse_add_argument_ex(parser, "-o", "--output", ARG_STRING, "Output", false, NULL, '=');
+
+    CHECK(!argparse_error_occurred());
+    return parser;
+}
+
+/* Values after a parse of "-r 3 -s name -v -n 1 2 -f=a,b". */
+static void check_sample(ArgParser* parser) {
+    const int* numbers = NULL;
+    const char* const* files = NULL;
+
+    CHECK(argparse_get_int(parser, "-r") == 3);
+    CHECK(argparse_get_string(parser, "--name") && !strcmp(argparse_get_string(parser, "--name"), "name"));
+    CHECK(argparse_get_bool(parser, "-v"));
+    CHECK(argparse_get_int_list_view(parser, "-n", &numbers) == 2 && numbers[1] == 2);
+    CHECK(argparse_get_string_list_view(parser, "-f", &files) == 2 && !strcmp(files[1], "b"));
+}
+
+/* Values after argparse_reset(): defaults back, lists empty. */
+static void check_reset(ArgParser* parser) {
+    CHECK(*(const int*)argparse_get_handle(parser, "-r")->value == 7);
+    CHECK(argparse_get_string(parser, "-s") == NULL);
+    CHECK(!argparse_get_bool(parser, "-v"));
+    CHECK(argparse_get_list_count(parser, "-n") == 0);
+    CHECK(argparse_get_list_count(parser, "-f") == 0);
+}
+
+static void test_argv(void) {
+    for (int arena = 0; arena < 2; arena++) {
+        ArgParser* parser = sample_parser(arena);
+        char* argv[] = { "test", "-r", "3", "-s", "name", "-v", "-n", "1", "2", "-f=a,b", NULL };
+
+        argparse_parse(parser, 10, argv);
+        CHECK(!argparse_error_occurred());
+        check_sample(parser);
+        argparse_free(parser);
+    }
+}
+
+static void test_reset_after_buffer(void) {
+    static const char line[] = "-r 3 -s 'name' -v -n 1 2 -f=a,b";
+
+    for (int arena = 0; arena < 2; arena++) {
+        ArgParser* parser = sample_parser(arena);
+
+        for (int pass = 0; pass < 3; pass++) {
+            argparse_parse_buffer(parser, line, sizeof(line) - 1);
+            CHECK(!argparse_error_occurred());
+            check_sample(parser);
+            argparse_reset(parser);
+            check_reset(parser);
+        }
+
+        argparse_free(parser);
+    }
+}
+
+static void test_reset_after_response_file(void) {
+    write_file(TEST_RESPONSE_FILE, "-r 3 -s name\n-v -n 1 2 -f=a,b\n");
+
+    for (int arena = 0; arena < 2; arena++) {
+        ArgParser* parser = sample_parser(arena);
+        char* argv[] = { "test", "@" TEST_RESPONSE_FILE, NULL };
+
+        argparse_set_flags(parser, ARGPARSE_RESPONSE_FILES);
+
+        for (int pass = 0; pass < 3; pass++) {
+            argparse_parse(parser, 2, argv);
+            CHECK(!argparse_error_occurred());
+            check_sample(parser);
+            argparse_reset(parser);
+            check_reset(parser);
+        }
+
+        argparse_free(parser);
+    }
+
+    remove(TEST_RESPONSE_FILE);
+}
+
+/* "-n 0 1 ... count-1", far larger than one arena block. */
+static char* number_line(int count, size_t* len) {
+    char* line = (char*)malloc((size_t)count * 8 + 8);
+    if (!line) return NULL;
+
+    size_t used = (size_t)sprintf(line, "-n");
+
+    for (int i = 0; i < count; i++)
+        used += (size_t)sprintf(line + used, " %d", i);
+
+    *len = used;
+    return line;
+}
+
+static void check_numbers(ArgParser* parser, int count) {
+    const int* numbers = NULL;
+
+    CHECK(argparse_get_int_list_view(parser, "-n", &numbers) == count);
+    CHECK(numbers && numbers[count - 1] == count - 1);
+}
+
+/* Oversized blocks are linked behind the arena head, reset must still find its first block. */
+static void test_reset_oversized(void) {
+    size_t len = 0;
+    char* line = number_line(8000, &len);
+    CHECK(line && len > 2 * ARGPARSE_ARENA_BLOCK_SIZE);
+    if (!line) return;
+
+    write_file(TEST_RESPONSE_FILE, line);
+
+    for (int arena = 0; arena < 2; arena++) {
+        ArgParser* parser = sample_parser(arena);
+        char* argv[] = { "test", "@" TEST_RESPONSE_FILE, NULL };
+
+        for (int pass = 0; pass < 3; pass++) {
+            argparse_parse_buffer(parser, line, len);
+            CHECK(!argparse_error_occurred());
+            check_numbers(parser, 8000);
+            argparse_reset(parser);
+            check_reset(parser);
+
+            /* a small parse in between, then the large one from a response file */
+            argparse_parse_buffer(parser, "-s name", 7);
+            CHECK(!strcmp(argparse_get_string(parser, "-s"), "name"));
+            argparse_reset(parser);
+
+            argparse_set_flags(parser, ARGPARSE_RESPONSE_FILES);
+            argparse_parse(parser, 2, argv);
+            CHECK(!argparse_error_occurred());
+            check_numbers(parser, 8000);
+            argparse_reset(parser);
+            check_reset(parser);
+            argparse_set_flags(parser, 0);
+        }
+
+        argparse_free(parser);
+    }
+
+    remove(TEST_RESPONSE_FILE);
+    free(line);
+}
+
+/* Blocks an arena holds, in use or spare. */
+static size_t arena_blocks(const ArgArena* arena) {
+    size_t count = 0;
+
+    for (const ArgArenaBlock* block = arena ? arena->head : NULL; block; block = block->next) count++;
+    for (const ArgArenaBlock* block = arena ? arena->spare : NULL; block; block = block->next) count++;
+
+    return count;
+}
+
+/* String values of an arena parser go to memory argparse_reset() recycles. */
+static void test_reset_loop_memory(void) {
+    static char value[1024];
+    memset(value, 'x', sizeof(value) - 1);
+
+    ArgParser* parser = sample_parser(true);
+    char* argv[] = { "test", "-s", value, "-f", value, value, "-o", value, NULL };
+    size_t parser_blocks = 0, pool_blocks = 0;
+
+    for (int pass = 0; pass < 200; pass++) {
+        argparse_parse(parser, 8, argv);
+        CHECK(!argparse_error_occurred());
+        CHECK(argparse_get_list_count(parser, "-f") == 2);
+        argparse_reset(parser);
+
+        /* the first pass sizes the list buffers and the pool, later ones reuse them */
+        if (pass == 0) {
+            parser_blocks = arena_blocks(parser->arena);
+            pool_blocks = arena_blocks(parser->string_pool);
+        }
+    }
+
+    CHECK(arena_blocks(parser->arena) == parser_blocks);
+    CHECK(arena_blocks(parser->string_pool) == pool_blocks);
+    check_reset(parser);
+    argparse_free(parser);
+}
+
+/* Builder that must never run, for parsers that only register a subcommand. */
+static ArgParser* unused_builder(void* user_data) {
+    (void)user_data;
+    CHECK(!"builder called");
+    return NULL;
+}
+
+static void test_schema_round_trip(void) {
+    ArgParser* parser = sample_parser(false);
+    size_t size = argparse_save_schema(parser, NULL, 0);
+    CHECK(size > sizeof(ArgSchemaHeader));
+
+    uint64_t* blob = (uint64_t*)malloc(size);
+    uint64_t* again = (uint64_t*)malloc(size);
+    CHECK(blob && again);
+    CHECK(argparse_save_schema(parser, blob, size - 1) == size);
+    CHECK(argparse_save_schema(parser, blob, size) == size);
+
+    ArgParser* loaded = argparse_load_schema(blob, size);
+    CHECK(loaded && !argparse_error_occurred());
+
+    if (loaded) {
+        /* a loaded schema saves back to the same bytes */
+        CHECK(argparse_save_schema(loaded, again, size) == size && !memcmp(blob, again, size));
+
+        char* argv[] = { "test", "-r", "3", "-s", "name", "-v", "-n", "1", "2", "-f=a,b", "-o=x", NULL };
+
+        argparse_parse(loaded, 11, argv);
+        CHECK(!argparse_error_occurred());
+        check_sample(loaded);
+        CHECK(!strcmp(argparse_get_string(loaded, "--output"), "x"));
+        argparse_free(loaded);
+    }
+
+    /* truncated or inconsistent blobs are rejected */
+    CHECK(!argparse_load_schema(blob, size - 1) && argparse_error_get_category() == APE_CONFIG);
+    ((ArgSchemaHeader*)blob)->count++;
+    CHECK(!argparse_load_schema(blob, size) && argparse_error_get_category() == APE_CONFIG);
+
+    free(again);
+    free(blob);
+
+    /* rules are not part of the blob, saving them would drop them silently */
+    const char* const members[] = { "-r", "-d" };
+    CHECK(argparse_add_exclusive_group(parser, members, 2, false));
+    CHECK(!argparse_save_schema(parser, NULL, 0) && argparse_error_get_category() == APE_CONFIG);
+    argparse_free(parser);
+
+    parser = sample_parser(false);
+    CHECK(argparse_add_dependency(parser, "-o", "-s"));
+    CHECK(!argparse_save_schema(parser, NULL, 0) && argparse_error_get_category() == APE_CONFIG);
+    argparse_free(parser);
+
+    /* neither are fallback sources nor parser flags */
+    parser = sample_parser(false);
+    CHECK(argparse_add_source(parser, ARGPARSE_SOURCE_ENV, "ARGPARSE_TEST_"));
+    CHECK(!argparse_save_schema(parser, NULL, 0) && argparse_error_get_category() == APE_CONFIG);
+    argparse_free(parser);
+
+    parser = sample_parser(false);
+    argparse_set_flags(parser, ARGPARSE_ALLOW_ABBREV);
+    CHECK(!argparse_save_schema(parser, NULL, 0) && argparse_error_get_category() == APE_CONFIG);
+    argparse_free(parser);
+
+    /* or subcommands, whose builders are caller code */
+    parser = sample_parser(false);
+    CHECK(argparse_add_subcommand(parser, "run", "Runs", unused_builder, NULL));
+    CHECK(!argparse_save_schema(parser, NULL, 0) && argparse_error_get_category() == APE_CONFIG);
+    argparse_free(parser);
+}
+
+static const int g_spec_round = 7;
+
+static const ArgSpec g_specs[] = {
+    ARGPARSE_SPEC_DEFAULT("-r", "--round", ARG_INT, "Rounds", false, &g_spec_round),
+    ARGPARSE_SPEC("-v", "--verbose", ARG_BOOL, "Verbose", false),
+    ARGPARSE_SPEC("-s", "--name", ARG_STRING, "Name", false),
+    ARGPARSE_SPEC_EX("-f", "--files", ARG_STRING_LIST, "Files", false, '=', ','),
+    ARGPARSE_SPEC(NULL, "--only-long", ARG_INT, "Long", false)
+};
+
+static void test_spec_index(void) {
+    size_t count = ARGPARSE_SPEC_COUNT(g_specs);
+    ArgSpecIndex* index = argparse_spec_index_create(g_specs, count);
+    CHECK(index != NULL);
+
+    /* with the perfect hash and without it, lookups must agree */
+    for (int indexed = 0; indexed < 2; indexed++) {
+        ArgParser* parser = argparse_new_from_spec("spec", g_specs, count, indexed ? index : NULL);
+        CHECK(parser != NULL);
+        if (!parser) continue;
+
+        argparse_add_argument(parser, "-k", "--dynamic", ARG_INT, "Added later", false, NULL);
+
+        const char* names[] = { "-r", "--round", "-v", "--verbose", "-s", "--name", "-f", "--files",
+            "--only-long", "-h", "--help", "-k", "--dynamic" };
+
+        for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+            CHECK(argparse_get_handle(parser, names[i]) != NULL);
+
+        CHECK(argparse_get_handle(parser, "--round") == argparse_get_handle(parser, "-r"));
+        CHECK(argparse_spec_lookup_internal(parser, "--roundx", 7) == argparse_get_handle(parser, "-r"));
+        CHECK(argparse_spec_lookup_internal(parser, "--rounds", 8) == NULL);
+        CHECK(argparse_get_handle(parser, "--nope") == NULL);
+        argparse_clear_error();
+
+        char* argv[] = { "spec", "--only-long", "5", "-v", "-f=a,b", "-k", "9", NULL };
+        argparse_parse(parser, 7, argv);
+        CHECK(!argparse_error_occurred());
+        CHECK(argparse_get_int(parser, "--only-long") == 5 && argparse_get_int(parser, "-k") == 9);
+        CHECK(*(const int*)argparse_get_handle(parser, "-r")->value == 7);
+        CHECK(argparse_get_list_count(parser, "--files") == 2);
+        argparse_free(parser);
+    }
+
+    argparse_spec_index_free(index);
+
+    /* duplicate names cannot be hashed */
+    ArgSpec duplicates[] = {
+        ARGPARSE_SPEC("-a", NULL, ARG_INT, "A", false),
+        ARGPARSE_SPEC("-a", NULL, ARG_INT, "A", false)
+    };
+
+    CHECK(!argparse_spec_index_create(duplicates, 2) && argparse_error_get_category() == APE_DUPLICATE);
+    argparse_clear_error();
+}
+
+static void test_parse_r_overlay(void) {
+    ArgParser* parser = sample_parser(true);
+    char* first[] = { "test", "-r", "3", "-s", "name", "-v", "-n", "1", "2", "-f=a,b", NULL };
+    char* second[] = { "test", "-s", "other", "-n", "5", NULL };
+
+    ArgParseResult* a = argparse_parse_r(parser, 10, first);
+    ArgParseResult* b = argparse_parse_r(parser, 5, second);
+    CHECK(argparse_result_error(a) == APE_SUCCESS && argparse_result_error(b) == APE_SUCCESS);
+
+    /* each result holds its own values, the parser keeps none of them */
+    CHECK(argparse_handle_get_int(argparse_result_get_handle(a, "-r")) == 3);
+    CHECK(!argparse_handle_is_set(argparse_result_get_handle(b, "-r")));
+    CHECK(*(const int*)argparse_result_get_handle(b, "-r")->value == 7);
+    CHECK(!strcmp(argparse_handle_get_string(argparse_result_get_handle(a, "-s")), "name"));
+    CHECK(!strcmp(argparse_handle_get_string(argparse_result_get_handle(b, "-s")), "other"));
+    CHECK(argparse_handle_get_list_count(argparse_result_get_handle(b, "-n")) == 1);
+    CHECK(argparse_get_string(parser, "-s") == NULL);
+
+    char* bad[] = { "test", "-r", "x", NULL };
+    ArgParseResult* c = argparse_parse_r(parser, 3, bad);
+    CHECK(argparse_result_error(c) == APE_TYPE && argparse_result_error_message(c)[0] != '\0');
+
+    argparse_result_free(c);
+    argparse_result_free(b);
+    argparse_result_free(a);
+    argparse_free(parser);
+}
+
+static ArgParseErrorCategory rule_error(ArgParser* parser, int argc, char** argv) {
+    ArgParseResult* result = argparse_parse_r(parser, argc, argv);
+    ArgParseErrorCategory error = argparse_result_error(result);
+    argparse_result_free(result);
+    return error;
+}
+
+static void test_rules(void) {
+    ArgParser* parser = sample_parser(false);
+    const char* group[] = { "-v", "--name" };
+
+    CHECK(argparse_add_exclusive_group(parser, group, 2, false));
+    CHECK(argparse_add_dependency(parser, "-d", "-r"));
+
+    char* alone[] = { "test", "-v", NULL };
+    char* both[] = { "test", "-v", "-s", "x", NULL };
+    char* missing[] = { "test", "-d", "1.5", NULL };
+    char* given[] = { "test", "-d", "1.5", "-r", "2", NULL };
+
+    CHECK(rule_error(parser, 2, alone) == APE_SUCCESS);
+    CHECK(rule_error(parser, 4, both) == APE_VALIDATION);
+    CHECK(rule_error(parser, 3, missing) == APE_REQUIRED);
+    CHECK(rule_error(parser, 5, given) == APE_SUCCESS);
+    argparse_free(parser);
+}
+
+static void test_completion(void) {
+    ArgParser* parser = sample_parser(false);
+    char* words[] = { "--ve" };
+    char output[256];
+    FILE* out = tmpfile();
+    CHECK(out != NULL);
+    if (!out) return;
+
+    CHECK(argparse_complete(parser, 1, words, out) == 1);
+    rewind(out);
+    size_t got = fread(output, 1, sizeof(output) - 1, out);
+    output[got] = '\0';
+    CHECK(!strcmp(output, "--verbose\tVerbose\n"));
+
+    fclose(out);
+    argparse_free(parser);
+}
+
+/* "__complete" is only a query when the program asks for it, and it never exits. */
+static void test_completion_query(void) {
+    ArgParser* parser = sample_parser(false);
+    char* query[] = { "test", ARGPARSE_COMPLETE_COMMAND, "--zzz", NULL };
+    char* normal[] = { "test", "-v", NULL };
+
+    ArgParseResult* result = argparse_parse_r(parser, 3, query);
+    CHECK(argparse_result_error(result) != APE_SUCCESS);
+    argparse_result_free(result);
+
+    argparse_set_flags(parser, ARGPARSE_COMPLETION);
+    CHECK(!argparse_completion_requested(parser));
+
+    /* no candidate matches, so nothing reaches stdout */
+    argparse_parse(parser, 3, query);
+    CHECK(!argparse_error_occurred() && argparse_completion_requested(parser));
+    CHECK(!argparse_get_bool(parser, "-v"));
+
+    argparse_parse(parser, 2, normal);
+    CHECK(!argparse_completion_requested(parser) && argparse_get_bool(parser, "-v"));
+    argparse_free(parser);
+}
+
+/* Parses "name value" alone; the caller frees the result. */
+static ArgParseResult* parse_one(const ArgParser* parser, const char* name, const char* value) {
+    char* argv[] = { "test", (char*)name, (char*)value, NULL };
+    return argparse_parse_r(parser, 3, argv);
+}
+
+static ArgParser* number_parser(void) {
+    ArgParser* parser = argparse_new("test");
+
+    argparse_add_argument(parser, "-i", "--int", ARG_INT, "Int", false, NULL);
+    argparse_add_argument(parser, "-x", "--double", ARG_DOUBLE, "Double", false, NULL);
+    argparse_add_list_argument_ex(parser, "-l", "--ints", ARG_INT_LIST, "Ints", false, 0, ',');
+    argparse_add_list_argument_ex(parser, "-y", "--doubles", ARG_DOUBLE_LIST, "Doubles", false, 0, ',');
+
+    CHECK(!argparse_error_occurred());
+    return parser;
+}
+
+/* Int value of a single "-i value" parse, or whether it failed. */
+static bool parse_int(const ArgParser* parser, const char* value, int* out) {
+    ArgParseResult* result = parse_one(parser, "-i", value);
+    bool ok = argparse_result_error(result) == APE_SUCCESS;
+
+    if (ok) *out = argparse_handle_get_int(argparse_result_get_handle(result, "-i"));
+    argparse_result_free(result);
+    return ok;
+}
+
+static bool parse_double(const ArgParser* parser, const char* value, double* out) {
+    ArgParseResult* result = parse_one(parser, "-x", value);
+    bool ok = argparse_result_error(result) == APE_SUCCESS;
+
+    if (ok) *out = argparse_handle_get_double(argparse_result_get_handle(result, "-x"));
+    argparse_result_free(result);
+    return ok;
+}
+
+/* The int fast path must agree with strtol at the edges of int. */
+static void test_number_int_limits(void) {
+    ArgParser* parser = number_parser();
+    int value = 0;
+
+    CHECK(parse_int(parser, "2147483647", &value) && value == INT_MAX);
+    CHECK(parse_int(parser, "-2147483648", &value) && value == INT_MIN);
+    CHECK(!parse_int(parser, "2147483648", &value));
+    CHECK(!parse_int(parser, "-2147483649", &value));
+
+    /* one past the limit falls through to strtol instead of being accepted */
+    CHECK(argparse_number_parse_int_internal("2147483648", 10, &value) == 0);
+    CHECK(argparse_number_parse_int_internal("-2147483648", 11, &value) == 11 && value == INT_MIN);
+
+    /* 16 or more digits take the vector run and then the slow path */
+    CHECK(parse_int(parser, "0000000000000000042", &value) && value == 42);
+    CHECK(!parse_int(parser, "1234567890123456", &value));
+    CHECK(argparse_number_digit_run_internal("12345678901234567890x", 21) == 20);
+
+    ArgParseResult* result = parse_one(parser, "-l", "2147483647,-2147483648,0000000000000000042");
+    const int* ints = NULL;
+
+    CHECK(argparse_result_error(result) == APE_SUCCESS);
+    CHECK(argparse_handle_get_int_list_view(argparse_result_get_handle(result, "-l"), &ints) == 3);
+    CHECK(ints && ints[0] == INT_MAX && ints[1] == INT_MIN && ints[2] == 42);
+    argparse_result_free(result);
+
+    result = parse_one(parser, "-l", "1,2147483648");
+    CHECK(argparse_result_error(result) != APE_SUCCESS);
+    argparse_result_free(result);
+
+    argparse_free(parser);
+}
+
+/* The exact double fast path hands anything it cannot round correctly to strtod. */
+static void test_number_double_fallback(void) {
+    ArgParser* parser = number_parser();
+    double value = 0.0;
+
+    /* 1e22 is the last exact power of ten, 1e23 is not */
+    CHECK(parse_double(parser, "1e22", &value) && value == 1e22);
+    CHECK(parse_double(parser, "1e23", &value) && value == strtod("1e23", NULL));
+    CHECK(argparse_number_parse_double_internal("1e23", 4, &value) == 0);
+
+    /* 2^53 + 1 needs more than 53 mantissa bits */
+    CHECK(parse_double(parser, "9007199254740993", &value) && value == strtod("9007199254740993", NULL));
+    CHECK(argparse_number_parse_double_internal("9007199254740993", 16, &value) == 0);
+
+    /* mantissas beyond 19 digits would overflow the uint64_t accumulator */
+    CHECK(parse_double(parser, "18446744073709551617", &value) &&
+        value == strtod("18446744073709551617", NULL));
+    CHECK(parse_double(parser, "0.12345678901234567890123", &value) &&
+        value == strtod("0.12345678901234567890123", NULL));
+    CHECK(argparse_number_parse_double_internal("18446744073709551617", 20, &value) == 0);
+
+    ArgParseResult* result = parse_one(parser, "-y", "1e22,1e23,9007199254740993");
+    const double* doubles = NULL;
+
+    CHECK(argparse_result_error(result) == APE_SUCCESS);
+    CHECK(argparse_handle_get_double_list_view(argparse_result_get_handle(result, "-y"), &doubles) == 3);
+    CHECK(doubles && doubles[0] == 1e22 && doubles[1] == strtod("1e23", NULL) &&
+        doubles[2] == strtod("9007199254740993", NULL));
+    argparse_result_free(result);
+
+    argparse_free(parser);
+}
+
+/* Repeated, leading and trailing delimiters do not produce elements. */
+static void test_number_empty_elements(void) {
+    ArgParser* parser = number_parser();
+    ArgParseResult* result = parse_one(parser, "-l", ",1,,2,");
+    const int* ints = NULL;
+
+    CHECK(argparse_result_error(result) == APE_SUCCESS);
+    CHECK(argparse_handle_get_int_list_view(argparse_result_get_handle(result, "-l"), &ints) == 2);
+    CHECK(ints && ints[0] == 1 && ints[1] == 2);
+    argparse_result_free(result);
+
+    result = parse_one(parser, "-y", ",,0.5,,");
+    const double* doubles = NULL;
+
+    CHECK(argparse_result_error(result) == APE_SUCCESS);
+    CHECK(argparse_handle_get_double_list_view(argparse_result_get_handle(result, "-y"), &doubles) == 1);
+    CHECK(doubles && doubles[0] == 0.5);
+    argparse_result_free(result);
+
+    /* only delimiters is a list without values */
+    result = parse_one(parser, "-l", ",,");
+    CHECK(argparse_result_error(result) == APE_SYNTAX);
+    argparse_result_free(result);
+
+    argparse_free(parser);
+}
+
+/* Command line, then environment, then file, then the default. */
+static void test_source_precedence(void) {
+    write_file(TEST_CONFIG_FILE, "# sample\nround = 5\nname = file\nratio = 2.5\nnumbers = 4 5\n");
+    setenv(TEST_ENV_PREFIX "NAME", "env", 1);
+
+    ArgParser* parser = sample_parser(false);
+    CHECK(argparse_add_source(parser, ARGPARSE_SOURCE_ENV, TEST_ENV_PREFIX));
+    CHECK(argparse_add_source(parser, ARGPARSE_SOURCE_FILE, TEST_CONFIG_FILE));
+
+    char* argv[] = { "test", "-r", "3", NULL };
+    const int* numbers = NULL;
+
+    argparse_parse(parser, 3, argv);
+    CHECK(!argparse_error_occurred());
+    CHECK(argparse_get_int(parser, "-r") == 3);
+    CHECK(!strcmp(argparse_get_string(parser, "-s"), "env"));
+    CHECK(argparse_get_double(parser, "-d") == 2.5);
+    CHECK(argparse_get_int_list_view(parser, "-n", &numbers) == 2 && numbers[1] == 5);
+    CHECK(!argparse_handle_is_set(argparse_get_handle(parser, "-v")));
+
+    argparse_free(parser);
+    unsetenv(TEST_ENV_PREFIX "NAME");
+    remove(TEST_CONFIG_FILE);
+}
+
+/* A bad fallback value does not fail the parse, the getter that converts it reports it. */
+static void test_source_lazy_error(void) {
+    setenv(TEST_ENV_PREFIX "ROUND", "many", 1);
+
+    ArgParser* parser = sample_parser(false);
+    CHECK(argparse_add_source(parser, ARGPARSE_SOURCE_ENV, TEST_ENV_PREFIX));
+
+    char* argv[] = { "test", "-s", "name", NULL };
+
+    argparse_parse(parser, 3, argv);
+    CHECK(!argparse_error_occurred());
+    CHECK(!strcmp(argparse_get_string(parser, "-s"), "name"));
+    CHECK(argparse_get_int(parser, "-r") == 0 && argparse_error_get_category() == APE_TYPE);
+
+    argparse_free(parser);
+    unsetenv(TEST_ENV_PREFIX "ROUND");
+}
+
+static void test_source_last_key(void) {
+    write_file(TEST_CONFIG_FILE, "name = first\n[section]\nname = \"second\"\n; name = comment\n");
+
+    ArgParser* parser = sample_parser(false);
+    CHECK(argparse_add_source(parser, ARGPARSE_SOURCE_FILE, TEST_CONFIG_FILE));
+
+    char* argv[] = { "test", NULL };
+
+    argparse_parse(parser, 1, argv);
+    CHECK(!strcmp(argparse_get_string(parser, "--name"), "second"));
+
+    argparse_free(parser);
+    remove(TEST_CONFIG_FILE);
+}
+
+/* Fallbacks are looked up again by the first read after argparse_reset(). */
+static void test_source_reset(void) {
+    setenv(TEST_ENV_PREFIX "NAME", "one", 1);
+
+    ArgParser* parser = sample_parser(false);
+    CHECK(argparse_add_source(parser, ARGPARSE_SOURCE_ENV, TEST_ENV_PREFIX));
+
+    char* argv[] = { "test", NULL };
+
+    argparse_parse(parser, 1, argv);
+    CHECK(!strcmp(argparse_get_string(parser, "-s"), "one"));
+    argparse_reset(parser);
+
+    setenv(TEST_ENV_PREFIX "NAME", "two", 1);
+    argparse_parse(parser, 1, argv);
+    CHECK(!strcmp(argparse_get_string(parser, "-s"), "two"));
+    argparse_reset(parser);
+
+    /* a value from argv is not overridden and leaves the source alone */
+    char* given[] = { "test", "-s", "argv", NULL };
+    argparse_parse(parser, 3, given);
+    CHECK(!strcmp(argparse_get_string(parser, "-s"), "argv"));
+
+    argparse_free(parser);
+    unsetenv(TEST_ENV_PREFIX "NAME");
+}
+
+/* Counts its calls through user_data. */
+static ArgParser* counting_builder(void* user_data) {
+    ++*(int*)user_data;
+
+    ArgParser* child = argparse_new("build");
+    argparse_add_argument(child, "-j", "--jobs", ARG_INT, "Jobs", false, NULL);
+    return child;
+}
+
+/* Children are built on first use only, then kept, selected and reset with the parent. */
+static void test_subcommand_lazy_build(void) {
+    int built = 0, unused = 0;
+    ArgParser* parser = sample_parser(false);
+
+    CHECK(argparse_add_subcommand(parser, "build", "Builds", counting_builder, &built));
+    CHECK(argparse_add_subcommand(parser, "clean", "Cleans", counting_builder, &unused));
+    CHECK(built == 0 && unused == 0);
+
+    char* plain[] = { "test", "-v", NULL };
+    argparse_parse(parser, 2, plain);
+    CHECK(built == 0 && !argparse_get_subcommand(parser, NULL));
+    argparse_reset(parser);
+
+    char* argv[] = { "test", "-v", "build", "-j", "4", NULL };
+    const char* name = NULL;
+
+    argparse_parse(parser, 5, argv);
+    ArgParser* child = argparse_get_subcommand(parser, &name);
+    CHECK(!argparse_error_occurred() && built == 1 && unused == 0);
+    CHECK(child && name && !strcmp(name, "build"));
+    CHECK(argparse_get_bool(parser, "-v") && child && argparse_get_int(child, "-j") == 4);
+
+    /* reset forgets the selection and the child's values, not the child */
+    argparse_reset(parser);
+    CHECK(!argparse_get_subcommand(parser, &name) && !name);
+    CHECK(child && !argparse_handle_is_set(argparse_get_handle(child, "-j")));
+
+    char* again[] = { "test", "build", NULL };
+    argparse_parse(parser, 2, again);
+    CHECK(argparse_get_subcommand(parser, NULL) == child && built == 1);
+    CHECK(child && !argparse_handle_is_set(argparse_get_handle(child, "-j")));
+
+    argparse_free(parser);
+}
+
+/* Long options sharing the stem "ver". */
+static ArgParser* abbrev_parser(unsigned flags) {
+    ArgParser* parser = argparse_new("test");
+
+    argparse_add_argument(parser, "-b", "--verbose", ARG_BOOL, "Verbose", false, NULL);
+    argparse_add_argument(parser, "-V", "--version", ARG_BOOL, "Version", false, NULL);
+    argparse_add_argument(parser, "-c", "--count", ARG_INT, "Count", false, NULL);
+    argparse_set_flags(parser, flags);
+
+    CHECK(!argparse_error_occurred());
+    return parser;
+}
+
+/* Error of a parse of "test word"; the hint stays readable until the next error call. */
+static ArgParseErrorCategory word_error(ArgParser* parser, const char* word) {
+    char* argv[] = { "test", (char*)word, NULL };
+    return rule_error(parser, 2, argv);
+}
+
+static void test_abbrev_ambiguity(void) {
+    ArgParser* parser = abbrev_parser(ARGPARSE_ALLOW_ABBREV);
+    char* argv[] = { "test", "--verb", "--vers", "--co", "2", NULL };
+
+    ArgParseResult* result = argparse_parse_r(parser, 5, argv);
+    CHECK(argparse_result_error(result) == APE_SUCCESS);
+    CHECK(argparse_handle_get_bool(argparse_result_get_handle(result, "--verbose")));
+    CHECK(argparse_handle_get_bool(argparse_result_get_handle(result, "--version")));
+    CHECK(argparse_handle_get_int(argparse_result_get_handle(result, "--count")) == 2);
+    argparse_result_free(result);
+
+    /* "--ver" starts both names, the hint names the two */
+    CHECK(word_error(parser, "--ver") == APE_SYNTAX);
+    CHECK(strstr(argparse_error_get_hint(), "--verbose") && strstr(argparse_error_get_hint(), "--version"));
+
+    /* short names and single dashes are never abbreviated */
+    CHECK(word_error(parser, "-ve") != APE_SUCCESS);
+    argparse_free(parser);
+
+    /* without the flag a prefix is an unknown option */
+    parser = abbrev_parser(0);
+    CHECK(word_error(parser, "--verb") != APE_SUCCESS);
+    argparse_free(parser);
+}
+
+/* Unknown options within a small edit distance of a name get it as hint. */
+static void test_abbrev_suggestion(void) {
+    ArgParser* parser = abbrev_parser(0);
+
+    CHECK(word_error(parser, "--verbos") == APE_UNKNOWN_ARG);
+    CHECK(!strcmp(argparse_error_get_hint(), "did you mean '--verbose'?"));
+
+    /* a transposition is one edit */
+    CHECK(word_error(parser, "--vresion") == APE_UNKNOWN_ARG);
+    CHECK(!strcmp(argparse_error_get_hint(), "did you mean '--version'?"));
+
+    /* four edits are beyond the bound for a name this long */
+    CHECK(word_error(parser, "--verbxxxx") == APE_SYNTAX && argparse_error_get_hint()[0] == '\0');
+
+    /* short words never get a suggestion */
+    CHECK(word_error(parser, "--cn") == APE_SYNTAX && argparse_error_get_hint()[0] == '\0');
+    argparse_free(parser);
+}
+
+/* What the batch callback saw, in call order. */
+typedef struct BatchLog {
+    size_t calls;
+    size_t stop_at;                 /* Index whose callback returns false */
+    ArgParseErrorCategory errors[4];
+    const char* names[4];           /* "-s" value, borrowed from the vector */
+} BatchLog;
+
+static bool batch_callback(ArgParser* parser, size_t index, ArgParseErrorCategory error,
+    void* user_data) {
+    BatchLog* log = (BatchLog*)user_data;
+
+    CHECK(index == log->calls);
+    log->errors[index] = error;
+    log->names[index] = error == APE_SUCCESS ? argparse_get_string(parser, "-s") : NULL;
+    log->calls++;
+    return index != log->stop_at;
+}
+
+static void test_parse_batch(void) {
+    ArgParser* parser = sample_parser(false);
+    char* ok[] = { "test", "-s", "first", NULL };
+    char* bad[] = { "test", "-r", "x", NULL };
+    char* empty[] = { "test", NULL };
+    char* last[] = { "test", "-s", "last", NULL };
+    char** const argvs[] = { ok, bad, empty, last };
+    const int argcs[] = { 3, 3, 1, 3 };
+
+    /* errors go to the callback per vector, values point into the vectors */
+    BatchLog log = { 0, 4, { APE_SUCCESS }, { NULL } };
+    CHECK(argparse_parse_batch(parser, 4, argcs, argvs, batch_callback, &log) == 4);
+    CHECK(log.calls == 4);
+    CHECK(log.errors[0] == APE_SUCCESS && log.names[0] == ok[2]);
+    CHECK(log.errors[1] == APE_TYPE);
+    CHECK(log.errors[2] == APE_SUCCESS && log.names[2] == NULL);
+    CHECK(log.errors[3] == APE_SUCCESS && log.names[3] == last[2]);
+
+    /* a false return ends the batch after that vector */
+    BatchLog stopped = { 0, 1, { APE_SUCCESS }, { NULL } };
+    CHECK(argparse_parse_batch(parser, 4, argcs, argvs, batch_callback, &stopped) == 2);
+    CHECK(stopped.calls == 2);
+
+    /* the parser copies strings again once the batch is over */
+    CHECK(!parser->borrow_strings && !parser->batch);
+    argparse_reset(parser);
+
+    argparse_parse(parser, 3, ok);
+    const char* name = argparse_get_string(parser, "-s");
+    CHECK(name && name != ok[2] && !strcmp(name, "first"));
+    argparse_reset(parser);
+
+    /* and a parser set to borrow keeps borrowing */
+    BatchLog borrowed = { 0, 4, { APE_SUCCESS }, { NULL } };
+    argparse_set_flags(parser, ARGPARSE_BORROW_ARGV);
+    CHECK(argparse_parse_batch(parser, 1, argcs, argvs, batch_callback, &borrowed) == 1);
+    CHECK(!parser->borrow_strings && !parser->batch);
+
+    argparse_parse(parser, 3, last);
+    CHECK(argparse_get_string(parser, "-s") == last[2]);
+
+    argparse_free(parser);
+}
+
+/* Elements a streaming callback received, copied since they only live for the call. */
+typedef struct StreamLog {
+    int count;
+    int sum;
+    size_t lengths[4];
+    bool terminated;                /* Every long element ended with its NUL */
+} StreamLog;
+
+static bool stream_strings(ArgHandle arg, const void* element, void* user_data) {
+    StreamLog* log = (StreamLog*)user_data;
+    const char* text = (const char*)element;
+    size_t len = strlen(text);
+
+    (void)arg;
+    if (len > 128) log->terminated = log->terminated && text[len - 1] == 'y';
+    if (log->count < 4) log->lengths[log->count] = len;
+    log->count++;
+    return strcmp(text, "reject") != 0;
+}
+
+static bool stream_ints(ArgHandle arg, const void* element, void* user_data) {
+    StreamLog* log = (StreamLog*)user_data;
+
+    (void)arg;
+    log->count++;
+    log->sum += *(const int*)element;
+    return true;
+}
+
+/* Elements reach the callback in order and are never stored, long ones included. */
+static void test_stream_callbacks(void) {
+    static char long_value[300];
+    char word[320];
+    StreamLog strings = { 0, 0, { 0 }, true }, ints = { 0, 0, { 0 }, true };
+
+    /* longer than the 128-byte stack slice, so it takes the heap path */
+    memset(long_value, 'y', sizeof(long_value) - 1);
+    snprintf(word, sizeof(word), "a,%s,bc", long_value);
+
+    ArgParser* parser = argparse_new("test");
+    ArgHandle names = argparse_add_list_argument_cb(parser, "-s", "--strings", ARG_STRING_LIST, "Strings",
+        false, 0, ',', stream_strings, &strings);
+    argparse_add_list_argument_cb(parser, "-i", "--ints", ARG_INT_LIST, "Ints", false, 0, ',',
+        stream_ints, &ints);
+    CHECK(names && !argparse_error_occurred());
+
+    char* argv[] = { "test", "-s", word, "-i", "1,2,39", NULL };
+    const char* const* view = NULL;
+
+    argparse_parse(parser, 5, argv);
+    CHECK(!argparse_error_occurred());
+    CHECK(strings.count == 3 && strings.lengths[0] == 1 && strings.lengths[1] == sizeof(long_value) - 1);
+    CHECK(strings.lengths[2] == 2 && strings.terminated);
+    CHECK(ints.count == 3 && ints.sum == 42);
+    CHECK(argparse_handle_is_set(names) && argparse_get_string_list_view(parser, "-s", &view) == 0);
+    argparse_reset(parser);
+
+    /* a false return fails the parse at that element */
+    char* rejected[] = { "test", "-s", "ok,reject,never", NULL };
+    strings.count = 0;
+    CHECK(rule_error(parser, 3, rejected) == APE_VALIDATION);
+    CHECK(strings.count == 2);
+
+    argparse_free(parser);
+}
+
+/* Borrowed values are the argv words themselves; without the flag they are copies. */
+static void test_borrow_argv(void) {
+    char* argv[] = { "test", "-s", "name", "-o=out", "-w", "one", "two", "-f=b,c", NULL };
+    const char* const* words = NULL;
+    const char* const* files = NULL;
+
+    for (int borrow = 0; borrow < 2; borrow++) {
+        ArgParser* parser = sample_parser(false);
+        argparse_add_list_argument(parser, "-w", "--words", ARG_STRING_LIST, "Words", false);
+        if (borrow) argparse_set_flags(parser, ARGPARSE_BORROW_ARGV);
+
+        argparse_parse(parser, 8, argv);
+        CHECK(!argparse_error_occurred());
+        CHECK(!strcmp(argparse_get_string(parser, "-s"), "name"));
+        CHECK((argparse_get_string(parser, "-s") == argv[2]) == (borrow != 0));
+
+        /* a GNU suffix value starts right after the '=' */
+        CHECK((argparse_get_string(parser, "-o") == argv[3] + 3) == (borrow != 0));
+
+        /* list words are borrowed whole, delimited slices are not terminated and get copied */
+        CHECK(argparse_get_string_list_view(parser, "-w", &words) == 2);
+        CHECK(words && (words[0] == argv[5] && words[1] == argv[6]) == (borrow != 0));
+        CHECK(argparse_get_string_list_view(parser, "-f", &files) == 2);
+        CHECK(files && !strcmp(files[0], "b") && files[0] != argv[7] + 3 && !strcmp(files[1], "c"));
+
+        argparse_free(parser);
+    }
+}
+
+/* Bound variables take parsed values and get their registration-time contents back on reset. */
+static void test_bind_reset(void) {
+    for (int arena = 0; arena < 2; arena++) {
+        int port = 80;
+        double ratio = 0.5;
+        bool verbose = false;
+        const char* name = "default";
+
+        ArgParser* parser = arena ? argparse_new_with_arena("test") : argparse_new("test");
+        CHECK(argparse_bind_int(parser, "-p", "--port", "Port", false, &port));
+        CHECK(argparse_bind_double(parser, "-d", "--ratio", "Ratio", false, &ratio));
+        CHECK(argparse_bind_bool(parser, "-b", "--verbose", "Verbose", false, &verbose));
+        CHECK(argparse_bind_string(parser, "-s", "--name", "Name", false, &name));
+
+        char* argv[] = { "test", "-p", "8080", "-d", "1.5", "-b", "-s", "given", NULL };
+
+        for (int pass = 0; pass < 2; pass++) {
+            argparse_parse(parser, 8, argv);
+            CHECK(!argparse_error_occurred());
+            CHECK(port == 8080 && ratio == 1.5 && verbose && name && !strcmp(name, "given"));
+
+            argparse_reset(parser);
+            CHECK(port == 80 && ratio == 0.5 && !verbose && name && !strcmp(name, "default"));
+        }
+
+        /* a parse that gives nothing leaves the defaults in place */
+        argparse_parse(parser, 1, argv);
+        CHECK(port == 80 && !verbose && !strcmp(name, "default"));
+
+        argparse_free(parser);
+    }
+}
+
+/* True when text holds a line of names padded to column, then help. */
+static bool help_line(const char* text, int column, const char* names, const char* help) {
+    char line[256];
+
+    snprintf(line, sizeof(line), "%-*s%s\n", column, names, help);
+    return strstr(text, line) != NULL;
+}
+
+/* Help text aligns on the widest names up to a fixed limit, longer names wrap below it. */
+static void test_format_help(void) {
+    char text[1024];
+    ArgParser* parser = argparse_new("tool");
+
+    argparse_add_argument(parser, "-x", NULL, ARG_INT, "Xray", false, NULL);
+    argparse_add_argument(parser, NULL, "--yy", ARG_BOOL, "Yank", true, NULL);
+
+    /* "  -x VALUE" is the widest, plus a two-space gap */
+    size_t length = argparse_format_help(parser, text, sizeof(text));
+    CHECK(length == strlen(text));
+    CHECK(help_line(text, 12, "  -x VALUE", "Xray"));
+    CHECK(help_line(text, 12, "  --yy", "Yank [required]"));
+
+    /* the column stops at 32, wider names put their help on the next line */
+    argparse_add_list_argument(parser, "-b", "--a-very-long-option-name", ARG_STRING_LIST, "Long", false);
+    argparse_add_argument(parser, "-a", "--alpha", ARG_INT, "Alpha", false, NULL);
+
+    length = argparse_format_help(parser, text, sizeof(text));
+    CHECK(length == strlen(text));
+    CHECK(help_line(text, 32, "  -x VALUE", "Xray"));
+    CHECK(help_line(text, 32, "  -a, --alpha VALUE", "Alpha"));
+    CHECK(strstr(text, "  -b, --a-very-long-option-name VALUE1 VALUE2 ...\n"
+        "                                Long\n"));
+
+    /* snprintf-like truncation: always terminated, full length returned */
+    char small[16];
+    CHECK(argparse_format_help(parser, small, sizeof(small)) == length);
+    CHECK(strlen(small) == sizeof(small) - 1 && !strncmp(small, text, sizeof(small) - 1));
+    CHECK(argparse_format_help(parser, NULL, 0) == length);
+
+    char* exact = (char*)malloc(length + 1);
+    CHECK(exact && argparse_format_help(parser, exact, length) == length);
+    CHECK(exact && strlen(exact) == length - 1);
+    CHECK(exact && argparse_format_help(parser, exact, length + 1) == length && !strcmp(exact, text));
+    free(exact);
+
+    argparse_free(parser);
+}
+
+int main(int argc, char** argv) {
+    static const Test tests[] = {
+        { "parse/argv",                     test_argv },
+        { "reset/after-buffer",             test_reset_after_buffer },
+        { "reset/after-response-file",      test_reset_after_response_file },
+        { "reset/oversized-allocations",    test_reset_oversized },
+        { "reset/arena-loop-memory",        test_reset_loop_memory },
+        { "schema/round-trip",              test_schema_round_trip },
+        { "spec/index-lookup",              test_spec_index },
+        { "parse-r/overlay",                test_parse_r_overlay },
+        { "rules/groups-dependencies",      test_rules },
+        { "complete/prefix",                test_completion },
+        { "complete/query-opt-in",          test_completion_query },
+        { "number/int-limits",              test_number_int_limits },
+        { "number/double-fallback",         test_number_double_fallback },
+        { "number/empty-list-elements",     test_number_empty_elements },
+        { "source/precedence",              test_source_precedence },
+        { "source/lazy-conversion-error",   test_source_lazy_error },
+        { "source/file-last-key",           test_source_last_key },
+        { "source/reset",                   test_source_reset },
+        { "subcommand/lazy-build",          test_subcommand_lazy_build },
+        { "abbrev/ambiguity",               test_abbrev_ambiguity },
+        { "abbrev/suggestion",              test_abbrev_suggestion },
+        { "batch/errors-and-stop",          test_parse_batch },
+        { "stream/list-callbacks",          test_stream_callbacks },
+        { "borrow/argv-identity",           test_borrow_argv },
+        { "bind/reset-defaults",            test_bind_reset },
+        { "help/format-alignment",          test_format_help }
+    };
+
+    /* optional substring filter, e.g. ./argparse_test parse/ */
+    const char* filter = argc > 1 ? argv[1] : NULL;
+    int failed_tests = 0;
+
+    for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+        if (filter && !strstr(tests[i].name, filter)) continue;
+
+        int before = g_failures;
+        tests[i].run();
+        argparse_clear_error();
+
+        printf("%-4s %s\n", g_failures == before ? "ok" : "FAIL", tests[i].name);
+        if (g_failures != before) failed_tests++;
+    }
+
+    if (failed_tests) {
+        printf("%d test(s) failed\n", failed_tests);
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}